@@ -40,12 +40,12 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION			1
-#define configUSE_IDLE_HOOK				0
+#define configUSE_IDLE_HOOK				( configUSE_TICKLESS_IDLE == 0 )
 #define configUSE_TICK_HOOK				1
 #define configCPU_CLOCK_HZ				( ( unsigned long ) 50000000 )
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 90 )
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 50 * 1024 ) )
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 32 * 1024 ) )
 #define configMAX_TASK_NAME_LEN			( 12 )
 #define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
@@ -55,6 +55,7 @@
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configCHECK_FOR_STACK_OVERFLOW	2
 #define configUSE_QUEUE_SETS			1
+#define configUSE_QUEUE_ZERO_COPY		1
 #define configUSE_COUNTING_SEMAPHORES	1
 
 #define configMAX_PRIORITIES			( 6UL )
@@ -62,12 +63,55 @@
 #define configQUEUE_REGISTRY_SIZE		10
 #define configSUPPORT_STATIC_ALLOCATION	1
 
+/* Stop the tick while all tasks are blocked and sleep until the next one is
+due (see LocalDemoFiles/lowpower.h).  Build with -DSNAKE_TICKLESS_IDLE=OFF to
+keep the tick running, in which case the idle hook sleeps between ticks
+instead. */
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE		1
+#endif
+
+void vLowPowerPreSleep( uint32_t *pxExpectedIdleTime );
+void vLowPowerPostSleep( uint32_t xExpectedIdleTime );
+#define configPRE_SLEEP_PROCESSING( xExpectedIdleTime )		vLowPowerPreSleep( &( xExpectedIdleTime ) )
+#define configPOST_SLEEP_PROCESSING( xExpectedIdleTime )	vLowPowerPostSleep( xExpectedIdleTime )
+
+/* Hold delayed tasks on a hashed timing wheel instead of the sorted delayed
+lists, so blocking and waking take the same time however many tasks are
+blocked.  Delays longer than configTIMING_WHEEL_SLOTS ticks wait on an overflow
+list until their revolution of the wheel.  Build with -DSNAKE_TIMING_WHEEL=ON to
+enable. */
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL		0
+#endif
+#define configTIMING_WHEEL_SLOTS		64
+
+/* The application allocates all of its kernel objects statically, so the
+heap can be left out altogether by building with -DSNAKE_ZERO_HEAP=ON, which
+sets this to 0. */
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+	#define configSUPPORT_DYNAMIC_ALLOCATION	1
+#endif
+
 /* Timer related defines. */
 #define configUSE_TIMERS				1
 #define configTIMER_TASK_PRIORITY		2
 #define configTIMER_QUEUE_LENGTH		20
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE )
 
+/* Hold active software timers on a hashed timing wheel instead of the sorted
+timer lists, so starting, stopping and expiring a timer take the same time
+however many timers are running.  Build with -DSNAKE_TIMER_WHEEL=ON to enable.
+The timer service task handles up to configTIMER_BATCH_SIZE commands, and up to
+as many timers expiring at once, each time it is woken.  A run of expired timers
+stops early if a callback sends a command, so the command is still handled
+before the next callback. */
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL		0
+#endif
+#define configTIMER_WHEEL_SLOTS			64
+#define configTIMER_BATCH_SIZE			8
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 
@@ -90,8 +134,9 @@ to exclude the API function. */
 /* This demo makes use of one or more example stats formatting functions.  These
 format the raw data provided by the uxTaskGetSystemState() function in to human
 readable ASCII form.  See the notes in the implementation of vTaskList() within
-FreeRTOS/Source/tasks.c for limitations. */
-#define configUSE_STATS_FORMATTING_FUNCTIONS	1
+FreeRTOS/Source/tasks.c for limitations.  They allocate their working
+buffer from the heap, so are not available in a build without one. */
+#define configUSE_STATS_FORMATTING_FUNCTIONS	configSUPPORT_DYNAMIC_ALLOCATION
 
 #define configKERNEL_INTERRUPT_PRIORITY 		( 255 )	/* All eight bits as QEMU doesn't model the priority bits. */
 /* !!!! configMAX_SYSCALL_INTERRUPT_PRIORITY must not be set to zero !!!!
@@ -113,6 +158,20 @@ demo. */
 #define configSTREAM_BUFFER_SENDER_TASK_STACK_SIZE 	( 180 )
 #define configSTREAM_BUFFER_SMALLER_TASK_STACK_SIZE	( 110 )
 
+/* The tick benchmark in LocalDemoFiles/benchmark.c times the tick handler and
+the insertion of a task into the delayed lists. */
+#if defined( mainRUN_BENCHMARKS ) && ( mainRUN_BENCHMARKS == 1 )
+	void vBenchmarkTickEnter( void );
+	void vBenchmarkTickExit( void );
+	void vBenchmarkDelayEnter( void );
+	void vBenchmarkDelayExit( void );
+	#define traceENTER_xTaskIncrementTick()						vBenchmarkTickEnter()
+	#define traceRETURN_xTaskIncrementTick( xSwitchRequired )	vBenchmarkTickExit()
+	#define traceTASK_DELAY_UNTIL( xTimeToWake )				vBenchmarkDelayEnter()
+	#define traceMOVED_TASK_TO_DELAYED_LIST()					vBenchmarkDelayExit()
+	#define traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST()			vBenchmarkDelayExit()
+#endif
+
 void vAssertCalled( const char *pcFile, unsigned long ulLine );
 #define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ );
 
@@ -0,0 +1,895 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * On-target benchmarks.  Each benchmark times a number of iterations of an
+ * operation against the Timer 1 cycle counter (see timestamp.h) and prints
+ * the total and per iteration cycle counts to UART0.  Build with
+ * -DSNAKE_BENCHMARKS=ON to run these instead of the game.
+ *
+ * Several of the benchmarks compare an old and a new implementation that are
+ * selected at compile time.  The build configuration is printed at the start
+ * of the run so the output of two builds can be compared side by side.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "queue.h"
+
+/* Library includes. */
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "ustdlib.h"
+#include "osram128x64x4.h"
+#include "snake.h"
+
+/* Demo includes. */
+#include "timestamp.h"
+#include "benchmark.h"
+#include "uartprint.h"
+
+#if !OSRAM_COMPARE_GLYPH_PATHS
+	#error The string draw benchmark needs OSRAM_COMPARE_GLYPH_PATHS set to 1.
+#endif
+
+/* The number of times each string drawing operation is repeated. */
+#define benchSTRING_DRAW_ITERATIONS		( 200UL )
+
+/* The string drawn by the string drawing benchmark - a full row of text. */
+#define benchSTRING						"Score: 1234 Len: 056"
+
+/* The number of game ticks timed at each snake length. */
+#define benchSNAKE_STEP_ITERATIONS		( 500UL )
+
+/* The size of the buffer used to format a benchmark name. */
+#define benchNAME_LENGTH				( 48 )
+
+/* The tick benchmark blocks up to benchTICK_MAX_TASKS periodic tasks on the
+delayed lists and times each call to xTaskIncrementTick() for
+benchTICK_RUN_TICKS ticks.  The periods run from benchTICK_MIN_PERIOD to
+benchTICK_MIN_PERIOD + benchTICK_PERIOD_SPREAD - 1 ticks, so most of them are
+longer than one revolution of the timing wheel when configUSE_TIMING_WHEEL is
+set.  The periodic tasks do nothing but block, so their stacks are kept small
+to fit 128 of them in SRAM; the smallest amount of stack left unused is printed
+after each run. */
+#define benchTICK_MAX_TASKS				( 128 )
+#define benchTICK_RUN_TICKS				( pdMS_TO_TICKS( 2000 ) )
+#define benchTICK_MIN_PERIOD			( 2UL )
+#define benchTICK_PERIOD_SPREAD			( 200UL )
+#define benchTICK_TASK_STACK_SIZE		( 64 )
+
+/* The timer benchmark starts up to benchTIMER_MAX_TIMERS auto-reload timers,
+times the start and reset commands and then lets the timers run for
+benchTIMER_RUN_TICKS ticks, recording how late the latest callback ran.  The
+commands are sent configTIMER_QUEUE_LENGTH at a time from above the priority
+of the timer service task, so each wakeup of the service task finds a full
+queue.  The periods are spread in the same way as the tick benchmark's. */
+#define benchTIMER_MAX_TIMERS			( 256 )
+#define benchTIMER_RUN_TICKS			( pdMS_TO_TICKS( 2000 ) )
+#define benchTIMER_MIN_PERIOD			( 2UL )
+#define benchTIMER_PERIOD_SPREAD		( 200UL )
+
+/* The queue benchmark passes benchQUEUE_ITERATIONS items of each size through
+a queue of benchQUEUE_LENGTH items, once by copy and once in place.  Each item
+is sent and then received straight away, so only the cost of the queue
+functions is timed. */
+#define benchQUEUE_ITERATIONS			( 1000UL )
+#define benchQUEUE_LENGTH				( 4 )
+#define benchQUEUE_MAX_ITEM_SIZE		( 512 )
+
+/* The batch benchmark sends benchBATCH_ITEMS items to a task of higher priority
+that is blocked on the queue, one at a time and then benchBATCH_SIZE at a time,
+with small items as sent by a UART receive path and larger ones as sent by a
+logger. */
+#define benchBATCH_ITEMS				( 1024UL )
+#define benchBATCH_SIZE					( 16 )
+#define benchBATCH_MAX_ITEM_SIZE		( 16 )
+
+/*-----------------------------------------------------------*/
+
+/* The task that runs each benchmark in turn. */
+static void prvBenchmarkTask( void *pvParameters );
+
+/* The benchmarks. */
+static void prvStringDrawBenchmark( void );
+static void prvSnakeStepBenchmark( void );
+static void prvTickBenchmark( void );
+static void prvTimerBenchmark( void );
+static void prvQueueBenchmark( void );
+static void prvQueueOverwriteCheck( void );
+static void prvQueueBatchBenchmark( void );
+
+/* A task that wakes at a fixed period. */
+static void prvPeriodicTask( void *pvParameters );
+
+/* Receives the items sent by the batch benchmark. */
+static void prvBatchReceiveTask( void *pvParameters );
+
+/* The callback of the timer benchmark's timers. */
+static void prvBenchTimerCallback( TimerHandle_t xTimer );
+
+/* Sends a command to each of the timer benchmark's timers and returns the
+cycles taken until the timer service task has processed all of them. */
+typedef BaseType_t ( *BenchTimerCommand_t )( TimerHandle_t xTimer );
+static uint32_t prvTimerCommandCycles( uint32_t ulCount, BenchTimerCommand_t pxCommand );
+static BaseType_t prvStartTimer( TimerHandle_t xTimer );
+static BaseType_t prvResetTimer( TimerHandle_t xTimer );
+static BaseType_t prvDeleteTimer( TimerHandle_t xTimer );
+
+/* Helpers for the snake benchmark. */
+static Direction prvCycleDirection( Point xCell );
+static Point prvCellMove( Point xCell, Direction eDirection );
+
+/*-----------------------------------------------------------*/
+
+/* The snake lengths at which the game tick is timed. */
+static const uint32_t ulSnakeLengths[] = { 4, 16, 64, 256, 1024 };
+
+/* Game state used by the headless snake benchmark.  Static as it is too large
+for the benchmark task's stack. */
+static GameState_t xBenchGameState;
+
+/* The numbers of periodic tasks blocked while the tick is timed. */
+static const uint32_t ulTickTaskCounts[] = { 4, 32, 128 };
+
+/* The sizes, in bytes, of the items passed through the queue benchmark. */
+static const uint32_t ulQueueItemSizes[] = { 4, 16, 64, 256, 512 };
+
+/* The sizes, in bytes, of the items passed through the batch benchmark. */
+static const uint32_t ulBatchItemSizes[] = { 1, benchBATCH_MAX_ITEM_SIZE };
+
+/* The ways of building a character that the string draw benchmark compares,
+in the order of the argument to OSRAM128x64x4GlyphAtlasEnable(). */
+static const char * const pcGlyphPaths[] = { "font", "atlas" };
+
+/* The numbers of timers running while the timer commands are timed. */
+static const uint32_t ulTimerCounts[] = { 16, 128, 256 };
+
+/* The periodic tasks of the tick benchmark and the timers of the timer
+benchmark.  The two benchmarks never run at the same time, so they share the
+memory rather than both taking their share of the SRAM. */
+static union
+{
+	struct
+	{
+		StaticTask_t xTCBs[ benchTICK_MAX_TASKS ];
+		StackType_t xStacks[ benchTICK_MAX_TASKS ][ benchTICK_TASK_STACK_SIZE ];
+	} xTick;
+	StaticTimer_t xTimers[ benchTIMER_MAX_TIMERS ];
+	struct
+	{
+		uint8_t ucStorage[ benchQUEUE_LENGTH * benchQUEUE_MAX_ITEM_SIZE ];
+		uint8_t ucItem[ benchQUEUE_MAX_ITEM_SIZE ];
+		uint8_t ucBatch[ benchBATCH_SIZE * benchBATCH_MAX_ITEM_SIZE ];
+		uint8_t ucReceived[ benchBATCH_SIZE * benchBATCH_MAX_ITEM_SIZE ];
+		StaticTask_t xReceiveTaskTCB;
+		StackType_t xReceiveTaskStack[ configMINIMAL_STACK_SIZE ];
+	} xQueue;
+} xBenchBuffers;
+static StaticQueue_t xBenchQueue;
+static TaskHandle_t xTickTasks[ benchTICK_MAX_TASKS ];
+static TimerHandle_t xBenchTimers[ benchTIMER_MAX_TIMERS ];
+
+/* Written by the kernel trace hooks while the tick benchmark runs.  The delay
+timings start in xTaskDelayUntil() and end once the task is on a delayed list,
+so they cover the insertion but not the context switch that follows. */
+static volatile BaseType_t xTickTiming = pdFALSE;
+static volatile uint32_t ulTickStart, ulTickCalls, ulTickCycles, ulTickMaxCycles;
+static volatile uint32_t ulDelayStart, ulDelayCalls, ulDelayCycles, ulDelayMaxCycles;
+static volatile BaseType_t xDelayStarted = pdFALSE;
+
+/* Written by the timer benchmark's callback, which runs in the timer service
+task. */
+static volatile uint32_t ulTimerCallbacks, ulTimerMaxLateness;
+
+/* Shared with the task that receives the batch benchmark's items. */
+static QueueHandle_t xBatchQueue;
+static volatile BaseType_t xBatchReceiveMultiple = pdFALSE;
+static volatile uint32_t ulBatchReceived;
+
+/* The benchmark task is statically allocated so the benchmarks also run in
+a build without a heap. */
+#define benchSTACK_SIZE		( configMINIMAL_STACK_SIZE * 3 )
+static StaticTask_t xBenchTaskTCB;
+static StackType_t xBenchTaskStack[ benchSTACK_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+void vStartBenchmarks( UBaseType_t uxPriority )
+{
+	xTaskCreateStatic( prvBenchmarkTask, "Bench", benchSTACK_SIZE, NULL, uxPriority, xBenchTaskStack, &xBenchTaskTCB );
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkReport( const char *pcName, uint32_t ulIterations, uint32_t ulCycles )
+{
+	vUARTPrintf( "%s: %u iterations, %u cycles, %u cycles/iteration\r\n",
+				 pcName, ( unsigned int ) ulIterations, ( unsigned int ) ulCycles,
+				 ( unsigned int ) ( ulCycles / ulIterations ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTimestampInit();
+	OSRAM128x64x4Init( 3500000 );
+
+	vUARTPrintString( "\r\nBenchmarks:\r\n" );
+
+	#if configUSE_TIMING_WHEEL
+		vUARTPrintString( "  configUSE_TIMING_WHEEL=1\r\n" );
+	#else
+		vUARTPrintString( "  configUSE_TIMING_WHEEL=0\r\n" );
+	#endif
+
+	#if configUSE_TIMER_WHEEL
+		vUARTPrintString( "  configUSE_TIMER_WHEEL=1\r\n" );
+	#else
+		vUARTPrintString( "  configUSE_TIMER_WHEEL=0\r\n" );
+	#endif
+	vUARTPrintf( "  configTIMER_BATCH_SIZE=%u\r\n", ( unsigned int ) configTIMER_BATCH_SIZE );
+
+	prvStringDrawBenchmark();
+	prvSnakeStepBenchmark();
+	prvTickBenchmark();
+	prvTimerBenchmark();
+	prvQueueOverwriteCheck();
+	prvQueueBenchmark();
+	prvQueueBatchBenchmark();
+
+	vUARTPrintString( "Benchmarks complete\r\n" );
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStringDrawBenchmark( void )
+{
+uint32_t ulPath, ulIteration, ulStart, ulEnd;
+char cName[ benchNAME_LENGTH ];
+
+	/* The benchmark build compiles in both ways of building a character, so
+	the old font expansion and the glyph table are timed in the same run. */
+	for( ulPath = 0; ulPath < ( sizeof( pcGlyphPaths ) / sizeof( pcGlyphPaths[ 0 ] ) ); ulPath++ )
+	{
+		OSRAM128x64x4GlyphAtlasEnable( ( ulPath != 0 ) ? true : false );
+
+		/* Drawing straight to the display.  This includes the time the SSI
+		takes to clock the data out, so the difference between the glyph paths
+		is smaller here than when drawing into the frame buffer. */
+		ulStart = ulTimestampGet();
+		for( ulIteration = 0; ulIteration < benchSTRING_DRAW_ITERATIONS; ulIteration++ )
+		{
+			OSRAM128x64x4StringDraw( benchSTRING, 0, 0, 15 );
+		}
+		ulEnd = ulTimestampGet();
+		usnprintf( cName, sizeof( cName ), "StringDraw %s level 15", pcGlyphPaths[ ulPath ] );
+		vBenchmarkReport( cName, benchSTRING_DRAW_ITERATIONS, ulEnd - ulStart );
+
+		ulStart = ulTimestampGet();
+		for( ulIteration = 0; ulIteration < benchSTRING_DRAW_ITERATIONS; ulIteration++ )
+		{
+			OSRAM128x64x4StringDraw( benchSTRING, 0, 8, 7 );
+		}
+		ulEnd = ulTimestampGet();
+		usnprintf( cName, sizeof( cName ), "StringDraw %s level 7", pcGlyphPaths[ ulPath ] );
+		vBenchmarkReport( cName, benchSTRING_DRAW_ITERATIONS, ulEnd - ulStart );
+
+		/* Drawing into the frame buffer, which is CPU time only.  After the
+		first iteration every byte already matches, so the remaining iterations
+		time the glyph fetch and compare without adding to the dirty list. */
+		OSRAM128x64x4FrameClear();
+		ulStart = ulTimestampGet();
+		for( ulIteration = 0; ulIteration < benchSTRING_DRAW_ITERATIONS; ulIteration++ )
+		{
+			OSRAM128x64x4FrameStringDraw( benchSTRING, 0, 16, 15 );
+		}
+		ulEnd = ulTimestampGet();
+		usnprintf( cName, sizeof( cName ), "FrameStringDraw %s level 15", pcGlyphPaths[ ulPath ] );
+		vBenchmarkReport( cName, benchSTRING_DRAW_ITERATIONS, ulEnd - ulStart );
+
+		ulStart = ulTimestampGet();
+		for( ulIteration = 0; ulIteration < benchSTRING_DRAW_ITERATIONS; ulIteration++ )
+		{
+			OSRAM128x64x4FrameStringDraw( benchSTRING, 0, 24, 7 );
+		}
+		ulEnd = ulTimestampGet();
+		usnprintf( cName, sizeof( cName ), "FrameStringDraw %s level 7", pcGlyphPaths[ ulPath ] );
+		vBenchmarkReport( cName, benchSTRING_DRAW_ITERATIONS, ulEnd - ulStart );
+
+		OSRAM128x64x4Flush();
+	}
+
+	OSRAM128x64x4GlyphAtlasEnable( OSRAM_USE_GLYPH_ATLAS ? true : false );
+}
+/*-----------------------------------------------------------*/
+
+static Direction prvCycleDirection( Point xCell )
+{
+	/* Returns the direction to move from xCell to follow a cycle that visits
+	every cell of the board: right along the top row, then back and forth
+	along the remaining rows without entering the left column, then up the
+	left column to the start.  A snake following the cycle never runs into
+	itself, whatever its length. */
+	if( xCell.y == 0 )
+	{
+		return ( xCell.x < ( BOARD_WIDTH - 1 ) ) ? DIR_RIGHT : DIR_DOWN;
+	}
+
+	if( xCell.x == 0 )
+	{
+		return DIR_UP;
+	}
+
+	if( ( xCell.y & 1 ) != 0 )
+	{
+		/* Odd rows are walked right to left. */
+		if( xCell.x > 1 )
+		{
+			return DIR_LEFT;
+		}
+
+		return ( xCell.y == ( BOARD_HEIGHT - 1 ) ) ? DIR_LEFT : DIR_DOWN;
+	}
+
+	return ( xCell.x < ( BOARD_WIDTH - 1 ) ) ? DIR_RIGHT : DIR_DOWN;
+}
+/*-----------------------------------------------------------*/
+
+static Point prvCellMove( Point xCell, Direction eDirection )
+{
+	switch( eDirection )
+	{
+		case DIR_UP:	xCell.y--; break;
+		case DIR_DOWN:	xCell.y++; break;
+		case DIR_LEFT:	xCell.x--; break;
+		default:		xCell.x++; break;
+	}
+
+	return xCell;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSnakeStepBenchmark( void )
+{
+uint32_t ulLengthIndex, ulLength, ulIteration, ulStart, ulCycles;
+Point xCell;
+Direction eDirection;
+char cName[ benchNAME_LENGTH ];
+
+	/* Times vSnakeGameStep() with snakes of increasing length.  Nothing is
+	drawn, so only the cost of the game rules and the body update is
+	measured. */
+	for( ulLengthIndex = 0; ulLengthIndex < ( sizeof( ulSnakeLengths ) / sizeof( ulSnakeLengths[ 0 ] ) ); ulLengthIndex++ )
+	{
+		ulLength = ulSnakeLengths[ ulLengthIndex ];
+
+		/* Lay the snake along the cycle starting from the top left cell, with
+		the food on that cell.  The head does not get back round to the food
+		within the timed ticks, so the length stays constant. */
+		vSnakeGameSeed( &xBenchGameState, ulLength );
+		vSnakeGameInit( &xBenchGameState );
+		vSnakeBodyInit( &xBenchGameState.body );
+		xCell.x = 0;
+		xCell.y = 0;
+		xBenchGameState.food = xCell;
+		for( ulIteration = 0; ulIteration < ulLength; ulIteration++ )
+		{
+			xCell = prvCellMove( xCell, prvCycleDirection( xCell ) );
+			vSnakeBodyPushHead( &xBenchGameState.body, xCell );
+		}
+
+		ulCycles = 0;
+		for( ulIteration = 0; ulIteration < benchSNAKE_STEP_ITERATIONS; ulIteration++ )
+		{
+			eDirection = prvCycleDirection( xCell );
+			xCell = prvCellMove( xCell, eDirection );
+
+			ulStart = ulTimestampGet();
+			vSnakeGameStep( &xBenchGameState, eDirection );
+			ulCycles += ulTimestampGet() - ulStart;
+		}
+
+		configASSERT( xBenchGameState.gameOver == pdFALSE );
+		configASSERT( xBenchGameState.body.length == ulLength );
+
+		usnprintf( cName, sizeof( cName ), "Snake step length %u", ( unsigned int ) ulLength );
+		vBenchmarkReport( cName, benchSNAKE_STEP_ITERATIONS, ulCycles );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTickEnter( void )
+{
+	if( xTickTiming != pdFALSE )
+	{
+		ulTickStart = ulTimestampGet();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkTickExit( void )
+{
+uint32_t ulCycles;
+
+	if( xTickTiming != pdFALSE )
+	{
+		ulCycles = ulTimestampGet() - ulTickStart;
+		ulTickCalls++;
+		ulTickCycles += ulCycles;
+
+		if( ulCycles > ulTickMaxCycles )
+		{
+			ulTickMaxCycles = ulCycles;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkDelayEnter( void )
+{
+	if( xTickTiming != pdFALSE )
+	{
+		ulDelayStart = ulTimestampGet();
+		xDelayStarted = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBenchmarkDelayExit( void )
+{
+uint32_t ulCycles;
+
+	/* Tasks also reach the delayed lists by blocking on a queue, which has
+	no matching start. */
+	if( xDelayStarted != pdFALSE )
+	{
+		xDelayStarted = pdFALSE;
+		ulCycles = ulTimestampGet() - ulDelayStart;
+		ulDelayCalls++;
+		ulDelayCycles += ulCycles;
+
+		if( ulCycles > ulDelayMaxCycles )
+		{
+			ulDelayMaxCycles = ulCycles;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+const TickType_t xPeriod = ( TickType_t ) ( uint32_t ) pvParameters;
+TickType_t xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		xTaskDelayUntil( &xLastWakeTime, xPeriod );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickBenchmark( void )
+{
+uint32_t ulCountIndex, ulCount, ulTask, ulPeriod;
+UBaseType_t uxTasksBefore, uxFree, uxMinFree;
+char cName[ benchNAME_LENGTH ];
+
+	uxTasksBefore = uxTaskGetNumberOfTasks();
+
+	for( ulCountIndex = 0; ulCountIndex < ( sizeof( ulTickTaskCounts ) / sizeof( ulTickTaskCounts[ 0 ] ) ); ulCountIndex++ )
+	{
+		ulCount = ulTickTaskCounts[ ulCountIndex ];
+
+		/* The periodic tasks run above this task so each one is back on a
+		delayed list as soon as it has been created. */
+		for( ulTask = 0; ulTask < ulCount; ulTask++ )
+		{
+			ulPeriod = benchTICK_MIN_PERIOD + ( ( ulTask * 37UL ) % benchTICK_PERIOD_SPREAD );
+			xTickTasks[ ulTask ] = xTaskCreateStatic( prvPeriodicTask, "Tick", benchTICK_TASK_STACK_SIZE, ( void * ) ulPeriod,
+													  uxTaskPriorityGet( NULL ) + 1, xBenchBuffers.xTick.xStacks[ ulTask ], &( xBenchBuffers.xTick.xTCBs[ ulTask ] ) );
+		}
+
+		taskENTER_CRITICAL();
+		{
+			ulTickCalls = 0;
+			ulTickCycles = 0;
+			ulTickMaxCycles = 0;
+			ulDelayCalls = 0;
+			ulDelayCycles = 0;
+			ulDelayMaxCycles = 0;
+			xDelayStarted = pdFALSE;
+			xTickTiming = pdTRUE;
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskDelay( benchTICK_RUN_TICKS );
+
+		taskENTER_CRITICAL();
+		{
+			xTickTiming = pdFALSE;
+		}
+		taskEXIT_CRITICAL();
+
+		uxMinFree = benchTICK_TASK_STACK_SIZE;
+		for( ulTask = 0; ulTask < ulCount; ulTask++ )
+		{
+			uxFree = uxTaskGetStackHighWaterMark( xTickTasks[ ulTask ] );
+			if( uxFree < uxMinFree )
+			{
+				uxMinFree = uxFree;
+			}
+
+			vTaskDelete( xTickTasks[ ulTask ] );
+		}
+
+		/* The idle task has to finish with the deleted tasks before their
+		buffers can be used again. */
+		while( uxTaskGetNumberOfTasks() > uxTasksBefore )
+		{
+			vTaskDelay( 1 );
+		}
+
+		usnprintf( cName, sizeof( cName ), "Tick with %u periodic tasks", ( unsigned int ) ulCount );
+		vBenchmarkReport( cName, ulTickCalls, ulTickCycles );
+		usnprintf( cName, sizeof( cName ), "Delay with %u periodic tasks", ( unsigned int ) ulCount );
+		vBenchmarkReport( cName, ulDelayCalls, ulDelayCycles );
+		vUARTPrintf( "  max tick %u cycles, max delay %u cycles, min free stack %u words\r\n",
+					 ( unsigned int ) ulTickMaxCycles, ( unsigned int ) ulDelayMaxCycles, ( unsigned int ) uxMinFree );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTimerCallback( TimerHandle_t xTimer )
+{
+uint32_t ulLateness;
+
+	/* The timer has already been reloaded, so the expiry being handled was
+	one period before the next. */
+	ulLateness = ( uint32_t ) ( xTaskGetTickCount() - ( xTimerGetExpiryTime( xTimer ) - xTimerGetPeriod( xTimer ) ) );
+	ulTimerCallbacks++;
+
+	if( ulLateness > ulTimerMaxLateness )
+	{
+		ulTimerMaxLateness = ulLateness;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStartTimer( TimerHandle_t xTimer )
+{
+	return xTimerStart( xTimer, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvResetTimer( TimerHandle_t xTimer )
+{
+	return xTimerReset( xTimer, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvDeleteTimer( TimerHandle_t xTimer )
+{
+	return xTimerDelete( xTimer, 0 );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvTimerCommandCycles( uint32_t ulCount, BenchTimerCommand_t pxCommand )
+{
+const UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+uint32_t ulTimer = 0, ulChunkEnd, ulStart;
+BaseType_t xResult;
+
+	ulStart = ulTimestampGet();
+
+	while( ulTimer < ulCount )
+	{
+		ulChunkEnd = ulTimer + configTIMER_QUEUE_LENGTH;
+		if( ulChunkEnd > ulCount )
+		{
+			ulChunkEnd = ulCount;
+		}
+
+		/* Fill the command queue without letting the timer service task run,
+		then drop below it so it empties the queue before this task continues. */
+		vTaskPrioritySet( NULL, configTIMER_TASK_PRIORITY + 1 );
+
+		for( ; ulTimer < ulChunkEnd; ulTimer++ )
+		{
+			xResult = pxCommand( xBenchTimers[ ulTimer ] );
+			configASSERT( xResult == pdPASS );
+			( void ) xResult;
+		}
+
+		vTaskPrioritySet( NULL, uxPriority );
+	}
+
+	return ulTimestampGet() - ulStart;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerBenchmark( void )
+{
+uint32_t ulCountIndex, ulCount, ulTimer, ulPeriod, ulCycles;
+char cName[ benchNAME_LENGTH ];
+
+	/* This task has to run below the timer service task for the commands it
+	sends to be processed as it waits. */
+	configASSERT( uxTaskPriorityGet( NULL ) < configTIMER_TASK_PRIORITY );
+
+	for( ulCountIndex = 0; ulCountIndex < ( sizeof( ulTimerCounts ) / sizeof( ulTimerCounts[ 0 ] ) ); ulCountIndex++ )
+	{
+		ulCount = ulTimerCounts[ ulCountIndex ];
+
+		for( ulTimer = 0; ulTimer < ulCount; ulTimer++ )
+		{
+			ulPeriod = benchTIMER_MIN_PERIOD + ( ( ulTimer * 37UL ) % benchTIMER_PERIOD_SPREAD );
+			xBenchTimers[ ulTimer ] = xTimerCreateStatic( "Bench", ( TickType_t ) ulPeriod, pdTRUE, NULL,
+														  prvBenchTimerCallback, &( xBenchBuffers.xTimers[ ulTimer ] ) );
+		}
+
+		ulTimerCallbacks = 0;
+		ulTimerMaxLateness = 0;
+
+		ulCycles = prvTimerCommandCycles( ulCount, prvStartTimer );
+		usnprintf( cName, sizeof( cName ), "Timer start with %u timers", ( unsigned int ) ulCount );
+		vBenchmarkReport( cName, ulCount, ulCycles );
+
+		/* Every timer is now running, so resetting one removes it from the
+		active timers before inserting it again. */
+		ulCycles = prvTimerCommandCycles( ulCount, prvResetTimer );
+		usnprintf( cName, sizeof( cName ), "Timer reset with %u timers", ( unsigned int ) ulCount );
+		vBenchmarkReport( cName, ulCount, ulCycles );
+
+		vTaskDelay( benchTIMER_RUN_TICKS );
+
+		/* The timers are statically allocated, so they are finished with as
+		soon as the timer service task has processed the delete commands. */
+		( void ) prvTimerCommandCycles( ulCount, prvDeleteTimer );
+
+		vUARTPrintf( "  %u callbacks, max lateness %u ticks\r\n",
+					 ( unsigned int ) ulTimerCallbacks, ( unsigned int ) ulTimerMaxLateness );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueBenchmark( void )
+{
+uint32_t ulSizeIndex, ulSize, ulIteration, ulStart, ulEnd;
+QueueHandle_t xQueue;
+uint8_t *pucSlot;
+const uint8_t *pucItem;
+uint8_t *pucItemBuffer = xBenchBuffers.xQueue.ucItem;
+volatile uint8_t ucRead;
+char cName[ benchNAME_LENGTH ];
+
+	for( ulSizeIndex = 0; ulSizeIndex < ( sizeof( ulQueueItemSizes ) / sizeof( ulQueueItemSizes[ 0 ] ) ); ulSizeIndex++ )
+	{
+		ulSize = ulQueueItemSizes[ ulSizeIndex ];
+		xQueue = xQueueCreateStatic( benchQUEUE_LENGTH, ulSize, xBenchBuffers.xQueue.ucStorage, &xBenchQueue );
+		configASSERT( xQueue );
+
+		/* By copy - the item is built in a buffer and copied into the queue,
+		then copied out into the same buffer. */
+		ulStart = ulTimestampGet();
+
+		for( ulIteration = 0; ulIteration < benchQUEUE_ITERATIONS; ulIteration++ )
+		{
+			pucItemBuffer[ 0 ] = ( uint8_t ) ulIteration;
+			xQueueSend( xQueue, pucItemBuffer, 0 );
+			xQueueReceive( xQueue, pucItemBuffer, 0 );
+			ucRead = pucItemBuffer[ 0 ];
+		}
+
+		ulEnd = ulTimestampGet();
+
+		usnprintf( cName, sizeof( cName ), "Queue copy %u byte item", ( unsigned int ) ulSize );
+		vBenchmarkReport( cName, benchQUEUE_ITERATIONS, ulEnd - ulStart );
+
+		/* In place - the item is written into, and read from, the queue
+		storage area. */
+		ulStart = ulTimestampGet();
+
+		for( ulIteration = 0; ulIteration < benchQUEUE_ITERATIONS; ulIteration++ )
+		{
+			xQueueSendAcquire( xQueue, ( void ** ) &pucSlot, 0 );
+			pucSlot[ 0 ] = ( uint8_t ) ulIteration;
+			xQueueSendCommit( xQueue, pucSlot );
+			xQueueReceiveBorrow( xQueue, ( void ** ) &pucItem, 0 );
+			ucRead = pucItem[ 0 ];
+			xQueueReceiveRelease( xQueue, pucItem );
+		}
+
+		ulEnd = ulTimestampGet();
+
+		usnprintf( cName, sizeof( cName ), "Queue zero copy %u byte item", ( unsigned int ) ulSize );
+		vBenchmarkReport( cName, benchQUEUE_ITERATIONS, ulEnd - ulStart );
+
+		( void ) ucRead;
+		vQueueDelete( xQueue );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Not a benchmark - checks that xQueueOverwrite() leaves alone a slot that is
+held by xQueueSendAcquire() or xQueueReceiveBorrow(), and that the queue counts
+stay consistent once the slot is handed back. */
+static void prvQueueOverwriteCheck( void )
+{
+QueueHandle_t xQueue;
+uint32_t *pulSlot;
+const uint32_t *pulItem;
+uint32_t ulValue, ulErrors = 0;
+
+	xQueue = xQueueCreateStatic( 1, sizeof( uint32_t ), xBenchBuffers.xQueue.ucStorage, &xBenchQueue );
+	configASSERT( xQueue );
+
+	/* An outstanding acquire - the overwrite must fail rather than write into
+	the acquired slot, and the commit must then leave exactly one item. */
+	xQueueSendAcquire( xQueue, ( void ** ) &pulSlot, 0 );
+	*pulSlot = 1UL;
+	ulValue = 2UL;
+
+	if( xQueueOverwrite( xQueue, &ulValue ) != errQUEUE_FULL )
+	{
+		ulErrors++;
+	}
+
+	xQueueSendCommit( xQueue, pulSlot );
+
+	if( ( uxQueueMessagesWaiting( xQueue ) != 1 ) || ( uxQueueSpacesAvailable( xQueue ) != 0 ) )
+	{
+		ulErrors++;
+	}
+
+	/* An outstanding borrow - the overwrite must fail rather than write into
+	the borrowed item, and the release must then leave the queue empty. */
+	xQueueReceiveBorrow( xQueue, ( void ** ) &pulItem, 0 );
+
+	if( *pulItem != 1UL )
+	{
+		ulErrors++;
+	}
+
+	if( xQueueOverwrite( xQueue, &ulValue ) != errQUEUE_FULL )
+	{
+		ulErrors++;
+	}
+
+	xQueueReceiveRelease( xQueue, pulItem );
+
+	if( ( uxQueueMessagesWaiting( xQueue ) != 0 ) || ( uxQueueSpacesAvailable( xQueue ) != 1 ) )
+	{
+		ulErrors++;
+	}
+
+	/* With nothing held the overwrite goes ahead as normal. */
+	if( ( xQueueOverwrite( xQueue, &ulValue ) != pdPASS ) ||
+		( xQueueOverwrite( xQueue, &ulValue ) != pdPASS ) ||
+		( uxQueueMessagesWaiting( xQueue ) != 1 ) )
+	{
+		ulErrors++;
+	}
+
+	vQueueDelete( xQueue );
+
+	vUARTPrintf( "Queue overwrite check: %s\r\n", ( ulErrors == 0 ) ? "passed" : "FAILED" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBatchReceiveTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xBatchReceiveMultiple != pdFALSE )
+		{
+			ulBatchReceived += ( uint32_t ) xQueueReceiveMultiple( xBatchQueue, xBenchBuffers.xQueue.ucReceived, benchBATCH_SIZE, portMAX_DELAY );
+		}
+		else if( xQueueReceive( xBatchQueue, xBenchBuffers.xQueue.ucReceived, portMAX_DELAY ) == pdPASS )
+		{
+			ulBatchReceived++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueBatchBenchmark( void )
+{
+uint32_t ulSizeIndex, ulSize, ulItem, ulStart, ulCycles;
+UBaseType_t uxTasksBefore;
+TaskHandle_t xReceiveTask;
+char cName[ benchNAME_LENGTH ];
+
+	uxTasksBefore = uxTaskGetNumberOfTasks();
+
+	for( ulSizeIndex = 0; ulSizeIndex < ( sizeof( ulBatchItemSizes ) / sizeof( ulBatchItemSizes[ 0 ] ) ); ulSizeIndex++ )
+	{
+		ulSize = ulBatchItemSizes[ ulSizeIndex ];
+		xBatchQueue = xQueueCreateStatic( benchBATCH_SIZE, ulSize, xBenchBuffers.xQueue.ucStorage, &xBenchQueue );
+		configASSERT( xBatchQueue );
+
+		/* The receiving task runs above this task, so it is blocked on the
+		queue whenever this task sends to it. */
+		xBatchReceiveMultiple = pdFALSE;
+		xReceiveTask = xTaskCreateStatic( prvBatchReceiveTask, "Batch", configMINIMAL_STACK_SIZE, NULL, uxTaskPriorityGet( NULL ) + 1,
+										  xBenchBuffers.xQueue.xReceiveTaskStack, &( xBenchBuffers.xQueue.xReceiveTaskTCB ) );
+
+		/* One item per call, each of which unblocks the receiving task. */
+		ulBatchReceived = 0;
+		ulStart = ulTimestampGet();
+
+		for( ulItem = 0; ulItem < benchBATCH_ITEMS; ulItem++ )
+		{
+			xQueueSend( xBatchQueue, xBenchBuffers.xQueue.ucBatch, portMAX_DELAY );
+		}
+
+		ulCycles = ulTimestampGet() - ulStart;
+		configASSERT( ulBatchReceived == benchBATCH_ITEMS );
+
+		usnprintf( cName, sizeof( cName ), "Queue send %u byte item", ( unsigned int ) ulSize );
+		vBenchmarkReport( cName, benchBATCH_ITEMS, ulCycles );
+		vUARTPrintf( "  %u items/s\r\n", ( unsigned int ) ( ( benchBATCH_ITEMS * 1000000UL ) / timestampCYCLES_TO_US( ulCycles ) ) );
+
+		/* benchBATCH_SIZE items per call, and one wakeup of the receiving
+		task for each call. */
+		xBatchReceiveMultiple = pdTRUE;
+		ulBatchReceived = 0;
+		ulStart = ulTimestampGet();
+
+		for( ulItem = 0; ulItem < benchBATCH_ITEMS; )
+		{
+			ulItem += ( uint32_t ) xQueueSendMultiple( xBatchQueue, xBenchBuffers.xQueue.ucBatch, benchBATCH_SIZE, portMAX_DELAY );
+		}
+
+		ulCycles = ulTimestampGet() - ulStart;
+		configASSERT( ulBatchReceived == benchBATCH_ITEMS );
+
+		usnprintf( cName, sizeof( cName ), "Queue send %u x %u byte items", ( unsigned int ) benchBATCH_SIZE, ( unsigned int ) ulSize );
+		vBenchmarkReport( cName, benchBATCH_ITEMS, ulCycles );
+		vUARTPrintf( "  %u items/s\r\n", ( unsigned int ) ( ( benchBATCH_ITEMS * 1000000UL ) / timestampCYCLES_TO_US( ulCycles ) ) );
+
+		/* The receiving task is blocked on the queue, so has to be deleted
+		before the queue. */
+		vTaskDelete( xReceiveTask );
+
+		while( uxTaskGetNumberOfTasks() > uxTasksBefore )
+		{
+			vTaskDelay( 1 );
+		}
+
+		vQueueDelete( xBatchQueue );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,46 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/* Creates the task that runs the on-target benchmarks and prints the results
+to UART0.  Used in place of the game when mainRUN_BENCHMARKS is set. */
+void vStartBenchmarks( UBaseType_t uxPriority );
+
+/* Print one line of results: the total cycles taken by ulIterations runs of
+the named operation and the average per run. */
+void vBenchmarkReport( const char *pcName, uint32_t ulIterations, uint32_t ulCycles );
+
+/* Called from the kernel trace macros defined in FreeRTOSConfig.h to time the
+tick handler and the insertion of a task into the delayed lists. */
+void vBenchmarkTickEnter( void );
+void vBenchmarkTickExit( void );
+void vBenchmarkDelayEnter( void );
+void vBenchmarkDelayExit( void );
+
+#endif
+
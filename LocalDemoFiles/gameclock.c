@@ -0,0 +1,370 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Fixed timestep game clock as described in gameclock.h. */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if gameclockUSE_HARDWARE_TIMER
+	/* Library includes. */
+	#include "hw_ints.h"
+	#include "hw_memmap.h"
+	#include "hw_types.h"
+	#include "interrupt.h"
+	#include "sysctl.h"
+	#include "lmi_timer.h"
+#endif
+
+/* Demo includes. */
+#include "timestamp.h"
+#include "uartprint.h"
+#include "gameclock.h"
+
+/* Timer 1 cycles per microsecond and per RTOS tick. */
+#define gameclockCYCLES_PER_US		( configCPU_CLOCK_HZ / 1000000UL )
+#define gameclockCYCLES_PER_TICK	( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+/*-----------------------------------------------------------*/
+
+/* Work out how many steps to run for a wakeup that found ulMissed further
+deadlines already passed, according to the catch up policy. */
+static uint32_t prvCatchUp( uint32_t ulMissed, uint32_t *pulDropped );
+
+/* Add one lateness measurement to the statistics. */
+static void prvRecordLateness( int32_t lLatenessCycles, uint32_t ulMissed, uint32_t ulDropped );
+
+#if gameclockUSE_HARDWARE_TIMER
+	/* Timer 0 interrupt handler, which wakes the game task at each deadline. */
+	void Timer0IntHandler( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if gameclockUSE_HARDWARE_TIMER
+
+	/* The period in Timer 0 cycles. */
+	static uint32_t ulPeriodCycles;
+
+	/* The Timer 1 count of the earliest deadline not yet waited for. */
+	static uint32_t ulNextDeadline;
+
+	/* The task notified by the timer interrupt, or NULL when stopped. */
+	static TaskHandle_t xClockTask = NULL;
+
+#else
+
+	/* The period in RTOS ticks, and the time of the deadline currently being
+	waited for in RTOS ticks, as maintained by xTaskDelayUntil(). */
+	static TickType_t xPeriodTicks;
+	static TickType_t xLastWakeTime;
+
+	/* The tick count and Timer 1 count of the start of the first period, used
+	to convert a deadline in ticks to a deadline in cycles. */
+	static TickType_t xBaseTick;
+	static uint32_t ulBaseCycles;
+
+#endif
+
+static eGameClockCatchUp eCatchUpPolicy;
+static UBaseType_t uxCatchUpLimit;
+
+static GameClockStats_t xStats;
+static const int32_t lHistogramEdges[ gameclockHISTOGRAM_BUCKETS - 1 ] = gameclockHISTOGRAM_EDGES;
+
+/*-----------------------------------------------------------*/
+
+#if gameclockUSE_HARDWARE_TIMER
+
+void vGameClockStart( uint32_t ulPeriodUs, eGameClockCatchUp eCatchUp, UBaseType_t uxMaxCatchUp )
+{
+	vTimestampInit();
+
+	/* Timer 0 runs at the CPU clock, so the period is kept to the exact
+	number of microseconds requested rather than rounded to whole RTOS
+	ticks. */
+	ulPeriodCycles = ulPeriodUs * gameclockCYCLES_PER_US;
+	eCatchUpPolicy = eCatchUp;
+	uxCatchUpLimit = uxMaxCatchUp;
+	vGameClockStatsReset();
+
+	SysCtlPeripheralEnable( SYSCTL_PERIPH_TIMER0 );
+	TimerConfigure( TIMER0_BASE, TIMER_CFG_32_BIT_PER );
+	TimerLoadSet( TIMER0_BASE, TIMER_A, ulPeriodCycles - 1UL );
+
+	/* The interrupt uses the FreeRTOS API so cannot be above
+	configMAX_SYSCALL_INTERRUPT_PRIORITY, but is above the kernel so the
+	wakeup is not held back by the tick interrupt. */
+	IntPrioritySet( INT_TIMER0A, configMAX_SYSCALL_INTERRUPT_PRIORITY );
+	TimerIntEnable( TIMER0_BASE, TIMER_TIMA_TIMEOUT );
+
+	/* Discard any notification left over from a previous game. */
+	xClockTask = xTaskGetCurrentTaskHandle();
+	( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+	taskENTER_CRITICAL();
+	{
+		TimerEnable( TIMER0_BASE, TIMER_A );
+		ulNextDeadline = ulTimestampGet() + ulPeriodCycles;
+	}
+	taskEXIT_CRITICAL();
+
+	IntEnable( INT_TIMER0A );
+}
+/*-----------------------------------------------------------*/
+
+void vGameClockStop( void )
+{
+	IntDisable( INT_TIMER0A );
+	TimerDisable( TIMER0_BASE, TIMER_A );
+	TimerIntClear( TIMER0_BASE, TIMER_TIMA_TIMEOUT );
+	xClockTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulGameClockWait( void )
+{
+uint32_t ulNow, ulExpired, ulMissed, ulSteps, ulDropped;
+int32_t lLateness;
+
+	/* Each expiry of the timer gives the task one notification, so the
+	count taken is the number of deadlines that have passed. */
+	ulExpired = ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	ulNow = ulTimestampGet();
+
+	lLateness = ( int32_t ) ( ulNow - ulNextDeadline );
+	ulMissed = ulExpired - 1UL;
+	ulSteps = prvCatchUp( ulMissed, &ulDropped );
+
+	if( ( ulMissed > 0 ) && ( eCatchUpPolicy == eGameClockRebase ) )
+	{
+		/* Restart the timer so the next deadline is one period from now. */
+		taskENTER_CRITICAL();
+		{
+			TimerDisable( TIMER0_BASE, TIMER_A );
+			TimerLoadSet( TIMER0_BASE, TIMER_A, ulPeriodCycles - 1UL );
+			TimerIntClear( TIMER0_BASE, TIMER_TIMA_TIMEOUT );
+			TimerEnable( TIMER0_BASE, TIMER_A );
+			ulNextDeadline = ulTimestampGet() + ulPeriodCycles;
+		}
+		taskEXIT_CRITICAL();
+		( void ) ulTaskNotifyTake( pdTRUE, 0 );
+	}
+	else
+	{
+		ulNextDeadline += ulExpired * ulPeriodCycles;
+	}
+
+	prvRecordLateness( lLateness, ulMissed, ulDropped );
+
+	return ulSteps;
+}
+/*-----------------------------------------------------------*/
+
+void Timer0IntHandler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	TimerIntClear( TIMER0_BASE, TIMER_TIMA_TIMEOUT );
+
+	if( xClockTask != NULL )
+	{
+		vTaskNotifyGiveFromISR( xClockTask, &xHigherPriorityTaskWoken );
+	}
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+#else /* gameclockUSE_HARDWARE_TIMER */
+
+void vGameClockStart( uint32_t ulPeriodUs, eGameClockCatchUp eCatchUp, UBaseType_t uxMaxCatchUp )
+{
+	vTimestampInit();
+
+	/* The RTOS tick sets the resolution, so round the period to a whole
+	number of ticks. */
+	xPeriodTicks = ( TickType_t ) ( ( ( uint64_t ) ulPeriodUs * configTICK_RATE_HZ + 500000UL ) / 1000000UL );
+	if( xPeriodTicks == 0 )
+	{
+		xPeriodTicks = 1;
+	}
+
+	eCatchUpPolicy = eCatchUp;
+	uxCatchUpLimit = uxMaxCatchUp;
+	vGameClockStatsReset();
+
+	/* Start on a tick boundary so the cycle count taken here is as close to
+	the start of a tick as a wakeup from xTaskDelayUntil() will be.  The
+	lateness is then relative to the normal wakeup latency. */
+	vTaskDelay( 1 );
+	xLastWakeTime = xTaskGetTickCount();
+	ulBaseCycles = ulTimestampGet();
+	xBaseTick = xLastWakeTime;
+}
+/*-----------------------------------------------------------*/
+
+void vGameClockStop( void )
+{
+	/* Nothing to do - the clock only runs while the task is waiting. */
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulGameClockWait( void )
+{
+uint32_t ulNow, ulDeadline, ulMissed, ulSteps, ulDropped;
+TickType_t xNow;
+
+	( void ) xTaskDelayUntil( &xLastWakeTime, xPeriodTicks );
+	ulNow = ulTimestampGet();
+	xNow = xTaskGetTickCount();
+
+	/* xLastWakeTime is now the deadline that was waited for.  Work out how
+	many later deadlines have also passed already. */
+	ulDeadline = ulBaseCycles + ( ( uint32_t ) ( xLastWakeTime - xBaseTick ) * gameclockCYCLES_PER_TICK );
+	ulMissed = ( uint32_t ) ( xNow - xLastWakeTime ) / xPeriodTicks;
+	ulSteps = prvCatchUp( ulMissed, &ulDropped );
+
+	if( ( ulMissed > 0 ) && ( eCatchUpPolicy == eGameClockRebase ) )
+	{
+		xLastWakeTime = xNow;
+	}
+	else
+	{
+		xLastWakeTime += ( TickType_t ) ( ulMissed * xPeriodTicks );
+	}
+
+	prvRecordLateness( ( int32_t ) ( ulNow - ulDeadline ), ulMissed, ulDropped );
+
+	return ulSteps;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* gameclockUSE_HARDWARE_TIMER */
+
+static uint32_t prvCatchUp( uint32_t ulMissed, uint32_t *pulDropped )
+{
+uint32_t ulExtra = 0;
+
+	if( eCatchUpPolicy == eGameClockBurst )
+	{
+		ulExtra = ( ulMissed < uxCatchUpLimit ) ? ulMissed : uxCatchUpLimit;
+	}
+
+	*pulDropped = ulMissed - ulExtra;
+
+	return 1UL + ulExtra;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecordLateness( int32_t lLatenessCycles, uint32_t ulMissed, uint32_t ulDropped )
+{
+int32_t lLatenessUs;
+uint32_t ulBucket;
+
+	lLatenessUs = lLatenessCycles / ( int32_t ) gameclockCYCLES_PER_US;
+
+	taskENTER_CRITICAL();
+	{
+		if( ( xStats.ulTicks == 0 ) || ( lLatenessUs < xStats.lMinLatenessUs ) )
+		{
+			xStats.lMinLatenessUs = lLatenessUs;
+		}
+
+		if( ( xStats.ulTicks == 0 ) || ( lLatenessUs > xStats.lMaxLatenessUs ) )
+		{
+			xStats.lMaxLatenessUs = lLatenessUs;
+		}
+
+		xStats.ulTicks++;
+		xStats.ulMissed += ulMissed;
+		xStats.ulDropped += ulDropped;
+		xStats.llTotalLatenessUs += lLatenessUs;
+
+		for( ulBucket = 0; ulBucket < ( gameclockHISTOGRAM_BUCKETS - 1 ); ulBucket++ )
+		{
+			if( lLatenessUs < lHistogramEdges[ ulBucket ] )
+			{
+				break;
+			}
+		}
+		xStats.ulHistogram[ ulBucket ]++;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vGameClockStatsGet( GameClockStats_t *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xStats;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vGameClockStatsReset( void )
+{
+	taskENTER_CRITICAL();
+	{
+		memset( &xStats, 0x00, sizeof( xStats ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vGameClockStatsPrint( void )
+{
+GameClockStats_t xCopy;
+uint32_t ulBucket;
+int32_t lAverage;
+
+	vGameClockStatsGet( &xCopy );
+
+	lAverage = ( xCopy.ulTicks > 0 ) ? ( int32_t ) ( xCopy.llTotalLatenessUs / xCopy.ulTicks ) : 0;
+
+	vUARTPrintf( "Game clock: %u ticks, %u missed, %u dropped\r\n",
+				 ( unsigned int ) xCopy.ulTicks, ( unsigned int ) xCopy.ulMissed,
+				 ( unsigned int ) xCopy.ulDropped );
+	vUARTPrintf( "  lateness us: min %d avg %d max %d\r\n",
+				 ( int ) xCopy.lMinLatenessUs, ( int ) lAverage, ( int ) xCopy.lMaxLatenessUs );
+
+	vUARTPrintf( "  < %d: %u\r\n", ( int ) lHistogramEdges[ 0 ], ( unsigned int ) xCopy.ulHistogram[ 0 ] );
+	for( ulBucket = 1; ulBucket < ( gameclockHISTOGRAM_BUCKETS - 1 ); ulBucket++ )
+	{
+		vUARTPrintf( "  %d - %d: %u\r\n", ( int ) lHistogramEdges[ ulBucket - 1 ],
+					 ( int ) lHistogramEdges[ ulBucket ] - 1, ( unsigned int ) xCopy.ulHistogram[ ulBucket ] );
+	}
+	vUARTPrintf( "  >= %d: %u\r\n", ( int ) lHistogramEdges[ gameclockHISTOGRAM_BUCKETS - 2 ],
+				 ( unsigned int ) xCopy.ulHistogram[ gameclockHISTOGRAM_BUCKETS - 1 ] );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,100 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+/*
+ * Fixed timestep clock for the game loop.  Deadlines are absolute - each one
+ * is exactly one period after the previous one, however long the game step
+ * took - so the cadence does not drift with the amount of work done per tick.
+ *
+ * The task that started the clock calls ulGameClockWait() in its loop.  The
+ * call blocks until the next deadline and returns the number of game steps
+ * to run, which is more than one only when deadlines were missed and the
+ * catch up policy asks for them to be made up.
+ *
+ * The lateness of each wakeup relative to its deadline is measured against
+ * the Timer 1 cycle counter (see timestamp.h) and kept as min/avg/max and a
+ * histogram, which vGameClockStatsPrint() prints to UART0.
+ *
+ * By default the deadlines are RTOS ticks and the task waits with
+ * xTaskDelayUntil(), so the period is rounded to a whole number of ticks.
+ * With gameclockUSE_HARDWARE_TIMER set, Timer 0 generates the deadlines
+ * instead and its interrupt wakes the task with a direct to task
+ * notification.  The period is then exact to a CPU cycle, independent of the
+ * SysTick, and the lateness is just the interrupt and context switch latency.
+ */
+
+#ifndef gameclockUSE_HARDWARE_TIMER
+	#define gameclockUSE_HARDWARE_TIMER		0
+#endif
+
+/* What to do when the game task wakes up after one or more further deadlines
+have already passed. */
+typedef enum
+{
+	eGameClockSkip = 0,	/* Run one step and drop the missed deadlines, staying on the original grid. */
+	eGameClockBurst,	/* Run a step for each missed deadline, up to uxMaxCatchUp, then drop the rest. */
+	eGameClockRebase	/* Run one step and start a new grid from now, so the missed time is lost. */
+} eGameClockCatchUp;
+
+/* The bucket edges of the lateness histogram, in microseconds.  Bucket 0
+counts early wakeups, bucket n counts lateness in the range
+[ edge n - 1, edge n ), and the last bucket counts everything later. */
+#define gameclockHISTOGRAM_EDGES	{ 0, 10, 50, 100, 500, 1000, 5000, 10000 }
+#define gameclockHISTOGRAM_BUCKETS	( 9 )
+
+typedef struct xGAME_CLOCK_STATS
+{
+	uint32_t ulTicks;			/* Wakeups measured. */
+	uint32_t ulMissed;			/* Deadlines that had already passed when the task woke. */
+	uint32_t ulDropped;			/* Missed deadlines for which no step was run. */
+	int32_t lMinLatenessUs;
+	int32_t lMaxLatenessUs;
+	int64_t llTotalLatenessUs;
+	uint32_t ulHistogram[ gameclockHISTOGRAM_BUCKETS ];
+} GameClockStats_t;
+
+/* Start the clock with the given period.  The first deadline is one period
+after the call.  Must be called from the task that then calls
+ulGameClockWait(). */
+void vGameClockStart( uint32_t ulPeriodUs, eGameClockCatchUp eCatchUp, UBaseType_t uxMaxCatchUp );
+
+/* Stop the clock.  Must be called before the task that started the clock is
+deleted. */
+void vGameClockStop( void );
+
+/* Block until the next deadline.  Returns the number of steps to run. */
+uint32_t ulGameClockWait( void );
+
+/* Access the lateness statistics. */
+void vGameClockStatsGet( GameClockStats_t *pxStats );
+void vGameClockStatsReset( void );
+void vGameClockStatsPrint( void );
+
+#endif
+
@@ -0,0 +1,357 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Interrupt driven UART0 keyboard input as described in input.h. */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* Library includes. */
+#include "hw_ints.h"
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "interrupt.h"
+#include "uart.h"
+
+/* Demo includes. */
+#include "input.h"
+#include "timestamp.h"
+#include "uartprint.h"
+
+#define inputESC					( ( char ) 0x1b )
+#define inputESC_TIMEOUT_CYCLES		( inputESC_TIMEOUT_MS * ( configCPU_CLOCK_HZ / 1000UL ) )
+
+/* The state of the escape sequence decoder. */
+typedef enum
+{
+	eInputIdle = 0,		/* Not in an escape sequence. */
+	eInputEscape,		/* ESC received. */
+	eInputSequence		/* "ESC [" or "ESC O" received, waiting for the final character. */
+} eInputState;
+
+typedef struct xINPUT_KEY_MAP
+{
+	char cChar;
+	Direction xDirection;
+} InputKeyMap_t;
+
+/*-----------------------------------------------------------*/
+
+/* Map a single character to a key using inputKEY_MAP.  Returns pdFALSE for
+characters that are not keys. */
+static BaseType_t prvDecodeKey( char cChar, KeyMsg *pxMsg );
+
+/* Advance the escape sequence decoder by one received character.  Returns
+pdTRUE when the character completes a key, which is written to pxMsg. */
+static BaseType_t prvParseChar( char cChar, KeyMsg *pxMsg );
+
+/* Returns pdTRUE if turning from xFrom to xTo would reverse the snake. */
+static BaseType_t prvIsReverse( Direction xFrom, Direction xTo );
+
+/* Check one key against the last accepted turn and buffer it if valid. */
+static void prvAcceptKey( const KeyMsg *pxKey );
+
+/*-----------------------------------------------------------*/
+
+/* The queue the interrupt posts keys to. */
+static QueueHandle_t xKeyQueue = NULL;
+
+static const InputKeyMap_t xKeyMap[] = inputKEY_MAP;
+
+/* Decoder state, only accessed from the interrupt. */
+static eInputState eParserState = eInputIdle;
+static uint32_t ulEscapeTime = 0;
+
+/* Accepted turns not yet applied, oldest first, and the most recently
+accepted turn, which is the direction the snake will be moving in once all
+the buffered turns have been applied. */
+static KeyMsg xTurns[ inputTURN_BUFFER_LENGTH ];
+static UBaseType_t uxTurnHead = 0, uxTurnCount = 0;
+static Direction xLastAccepted = DIR_RIGHT;
+
+/* Keys the interrupt could not post because the queue was full.  Kept apart
+from xStats so the interrupt never writes to the structure the task
+updates. */
+static volatile uint32_t ulQueueFullDrops = 0;
+
+/* Set by the interrupt when KEY_STATS is received. */
+static volatile BaseType_t xStatsRequested = pdFALSE;
+
+static InputStats_t xStats;
+
+/*-----------------------------------------------------------*/
+
+void vInputInit( QueueHandle_t xQueue )
+{
+	xKeyQueue = xQueue;
+
+	/* Timer 1 times the gap between the characters of an escape sequence. */
+	vTimestampInit();
+
+	/* Interrupt as soon as a quarter of the FIFO is used, and use the
+	receive timeout interrupt to pick up single key presses, which then
+	arrive within 32 bit periods instead of waiting for the FIFO to fill. */
+	UARTFIFOLevelSet( UART0_BASE, UART_FIFO_TX4_8, UART_FIFO_RX2_8 );
+	UARTIntClear( UART0_BASE, UART_INT_RX | UART_INT_RT );
+	UARTIntEnable( UART0_BASE, UART_INT_RX | UART_INT_RT );
+
+	/* The handler uses the FreeRTOS API so must run at or below
+	configMAX_SYSCALL_INTERRUPT_PRIORITY.  Input is not time critical so use
+	the lowest priority. */
+	IntPrioritySet( INT_UART0, configKERNEL_INTERRUPT_PRIORITY );
+	IntEnable( INT_UART0 );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvDecodeKey( char cChar, KeyMsg *pxMsg )
+{
+UBaseType_t uxKey;
+
+	for( uxKey = 0; uxKey < ( sizeof( xKeyMap ) / sizeof( xKeyMap[ 0 ] ) ); uxKey++ )
+	{
+		if( xKeyMap[ uxKey ].cChar == cChar )
+		{
+			pxMsg->dir = xKeyMap[ uxKey ].xDirection;
+			return pdTRUE;
+		}
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvParseChar( char cChar, KeyMsg *pxMsg )
+{
+BaseType_t xReturn = pdFALSE;
+
+	/* A sequence that has not completed in time started with a lone ESC, so
+	this character is not part of it. */
+	if( ( eParserState != eInputIdle ) && ( ( ulTimestampGet() - ulEscapeTime ) > inputESC_TIMEOUT_CYCLES ) )
+	{
+		eParserState = eInputIdle;
+	}
+
+	if( eParserState == eInputSequence )
+	{
+		if( ( cChar >= 0x20 ) && ( cChar <= 0x3f ) )
+		{
+			/* A parameter or intermediate character, such as the "1;5" of a
+			modified arrow key.  Wait for the final character. */
+		}
+		else
+		{
+			eParserState = eInputIdle;
+			xReturn = pdTRUE;
+
+			switch( cChar )
+			{
+				case 'A':	pxMsg->dir = DIR_UP;	break;
+				case 'B':	pxMsg->dir = DIR_DOWN;	break;
+				case 'C':	pxMsg->dir = DIR_RIGHT;	break;
+				case 'D':	pxMsg->dir = DIR_LEFT;	break;
+				default:	xReturn = pdFALSE;		break;
+			}
+		}
+	}
+	else if( ( eParserState == eInputEscape ) && ( ( cChar == '[' ) || ( cChar == 'O' ) ) )
+	{
+		eParserState = eInputSequence;
+	}
+	else
+	{
+		/* Either not in a sequence, or an ESC followed by something that
+		does not start one - the ESC was a key on its own and this character
+		is decoded normally. */
+		eParserState = eInputIdle;
+
+		if( cChar == inputESC )
+		{
+			eParserState = eInputEscape;
+			ulEscapeTime = ulTimestampGet();
+		}
+		else if( cChar == KEY_STATS )
+		{
+			xStatsRequested = pdTRUE;
+		}
+		else
+		{
+			xReturn = prvDecodeKey( cChar, pxMsg );
+		}
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void UART0IntHandler( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+unsigned long ulStatus;
+KeyMsg xMsg;
+char cChar;
+
+	ulStatus = UARTIntStatus( UART0_BASE, pdTRUE );
+	UARTIntClear( UART0_BASE, ulStatus );
+
+	/* Empty the FIFO, posting each key.  The queue send does not block, so
+	keys that arrive while the queue is full are lost. */
+	while( UARTCharsAvail( UART0_BASE ) )
+	{
+		cChar = ( char ) UARTCharGetNonBlocking( UART0_BASE );
+
+		if( ( prvParseChar( cChar, &xMsg ) != pdFALSE ) && ( xKeyQueue != NULL ) )
+		{
+			xMsg.ulTimestamp = ulTimestampGet();
+
+			if( xQueueSendFromISR( xKeyQueue, &xMsg, &xHigherPriorityTaskWoken ) != pdPASS )
+			{
+				ulQueueFullDrops++;
+			}
+		}
+	}
+
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsReverse( Direction xFrom, Direction xTo )
+{
+	return ( ( xFrom == DIR_UP ) && ( xTo == DIR_DOWN ) ) ||
+		   ( ( xFrom == DIR_DOWN ) && ( xTo == DIR_UP ) ) ||
+		   ( ( xFrom == DIR_LEFT ) && ( xTo == DIR_RIGHT ) ) ||
+		   ( ( xFrom == DIR_RIGHT ) && ( xTo == DIR_LEFT ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAcceptKey( const KeyMsg *pxKey )
+{
+Direction xKey = pxKey->dir;
+
+	xStats.ulKeys++;
+
+	if( xKey == xLastAccepted )
+	{
+		/* Already turning that way, so the key has no effect. */
+		xStats.ulCoalesced++;
+	}
+	else if( prvIsReverse( xLastAccepted, xKey ) != pdFALSE )
+	{
+		xStats.ulRejected++;
+	}
+	else if( uxTurnCount >= inputTURN_BUFFER_LENGTH )
+	{
+		xStats.ulDropped++;
+	}
+	else
+	{
+		xTurns[ ( uxTurnHead + uxTurnCount ) % inputTURN_BUFFER_LENGTH ] = *pxKey;
+		uxTurnCount++;
+		xLastAccepted = xKey;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vInputTurnsReset( Direction xCurrent )
+{
+	if( xKeyQueue != NULL )
+	{
+		( void ) xQueueReset( xKeyQueue );
+	}
+
+	uxTurnHead = 0;
+	uxTurnCount = 0;
+	xLastAccepted = xCurrent;
+
+	taskENTER_CRITICAL();
+	{
+		ulQueueFullDrops = 0;
+		memset( &xStats, 0x00, sizeof( xStats ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xInputNextTurn( KeyMsg *pxTurn )
+{
+KeyMsg xMsg;
+BaseType_t xReturn = pdFALSE;
+
+	/* Drain the queue now, not one key per step, so keys pressed in quick
+	succession are validated in the order they were pressed and the queue
+	does not fill up while turns wait to be applied. */
+	while( xQueueReceive( xKeyQueue, &xMsg, 0 ) == pdPASS )
+	{
+		prvAcceptKey( &xMsg );
+	}
+
+	if( uxTurnCount > 0 )
+	{
+		*pxTurn = xTurns[ uxTurnHead ];
+		uxTurnHead = ( uxTurnHead + 1 ) % inputTURN_BUFFER_LENGTH;
+		uxTurnCount--;
+		xStats.ulApplied++;
+		xReturn = pdTRUE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xInputStatsRequested( void )
+{
+BaseType_t xReturn = xStatsRequested;
+
+	xStatsRequested = pdFALSE;
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vInputStatsGet( InputStats_t *pxStats )
+{
+	*pxStats = xStats;
+	pxStats->ulDropped += ulQueueFullDrops;
+}
+/*-----------------------------------------------------------*/
+
+void vInputStatsPrint( void )
+{
+InputStats_t xCopy;
+
+	vInputStatsGet( &xCopy );
+
+	vUARTPrintf( "Input: %u keys, %u applied, %u coalesced, %u rejected, %u dropped\r\n",
+				 ( unsigned int ) xCopy.ulKeys, ( unsigned int ) xCopy.ulApplied,
+				 ( unsigned int ) xCopy.ulCoalesced, ( unsigned int ) xCopy.ulRejected,
+				 ( unsigned int ) xCopy.ulDropped );
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,132 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+/* Interrupt driven keyboard input from UART0.
+ *
+ * The UART0 receive interrupt decodes each character as it arrives and posts
+ * the resulting key to the queue passed to vInputInit(), so there is no
+ * polling task and nothing runs while no keys are pressed.
+ *
+ * During a game the snake task takes its turns through xInputNextTurn()
+ * rather than reading the queue itself.  Each key is checked against the
+ * last turn accepted - not the direction the snake is currently moving in -
+ * so a quick "up, left" while moving right is two valid turns.  Accepted
+ * turns wait in a short buffer and are applied one per game step in the
+ * order they were pressed.
+ *
+ * Besides the single character keys in inputKEY_MAP, the interrupt decodes
+ * the arrow keys, which a terminal sends as "ESC [ A" to "ESC [ D" (or
+ * "ESC O A" to "ESC O D" in application cursor mode), possibly with
+ * modifier parameters such as "ESC [ 1 ; 5 A".  The decoder is a state
+ * machine advanced one character at a time, so nothing is buffered.  An
+ * ESC that is not followed by the rest of a sequence within
+ * inputESC_TIMEOUT_MS is treated as a lone ESC key, which is ignored, so a
+ * stray ESC cannot swallow a later key.
+ */
+
+/* Demo includes. */
+#include "snake.h"
+
+/* The characters used to steer the snake and restart the game. */
+#define KEY_UP		'w'
+#define KEY_DOWN	's'
+#define KEY_LEFT	'a'
+#define KEY_RIGHT	'd'
+#define KEY_R		'r'
+
+/* Asks for the latency statistics to be printed, see xInputStatsRequested(). */
+#define KEY_STATS	'?'
+
+/* The single character keys and the direction each one maps to.  Define
+inputKEY_MAP before this file is included (or on the compiler command line)
+to use different keys.  Upper case is listed so caps lock does not stop the
+game responding. */
+#ifndef inputKEY_MAP
+	#define inputKEY_MAP										\
+	{															\
+		{ KEY_UP, DIR_UP }, { KEY_DOWN, DIR_DOWN },				\
+		{ KEY_LEFT, DIR_LEFT }, { KEY_RIGHT, DIR_RIGHT },		\
+		{ 'W', DIR_UP }, { 'S', DIR_DOWN },						\
+		{ 'A', DIR_LEFT }, { 'D', DIR_RIGHT },					\
+		{ KEY_R, R }, { 'R', R }								\
+	}
+#endif
+
+/* How long the rest of an escape sequence may take to arrive after the ESC.
+A terminal sends the whole sequence at once, so at any normal baud rate the
+characters are well under a millisecond apart. */
+#ifndef inputESC_TIMEOUT_MS
+	#define inputESC_TIMEOUT_MS		( 20 )
+#endif
+
+/* The item posted to the key queue for each recognised key. */
+typedef struct
+{
+	Direction dir;
+	uint32_t ulTimestamp;	/* Timer 1 count when the key was decoded, see timestamp.h. */
+} KeyMsg;
+
+/* The number of accepted turns that can wait to be applied. */
+#define inputTURN_BUFFER_LENGTH		( 4 )
+
+typedef struct xINPUT_STATS
+{
+	uint32_t ulKeys;		/* Keys taken from the queue. */
+	uint32_t ulApplied;		/* Turns returned by xInputNextTurn(). */
+	uint32_t ulCoalesced;	/* Keys for the direction already turned to. */
+	uint32_t ulRejected;	/* Keys that would reverse the snake onto itself. */
+	uint32_t ulDropped;		/* Keys lost because the queue or the turn buffer was full. */
+} InputStats_t;
+
+/* Enable the UART0 receive interrupt.  Recognised keys are posted to xQueue,
+which must hold KeyMsg items.  Keys that arrive while the queue is full are
+discarded. */
+void vInputInit( QueueHandle_t xQueue );
+
+/* Discard any pending keys and turns and reset the statistics.  xCurrent is
+the direction the snake starts a new game moving in. */
+void vInputTurnsReset( Direction xCurrent );
+
+/* Called once per game step by the task that owns the key queue.  Moves any
+keys waiting in the queue into the turn buffer, then removes the next turn to
+apply into pxTurn.  Returns pdFALSE, leaving pxTurn unchanged, if there is no
+turn to apply. */
+BaseType_t xInputNextTurn( KeyMsg *pxTurn );
+
+/* Returns pdTRUE, once, after KEY_STATS has been received. */
+BaseType_t xInputStatsRequested( void );
+
+/* Access the input statistics. */
+void vInputStatsGet( InputStats_t *pxStats );
+void vInputStatsPrint( void );
+
+/* UART0 interrupt handler, installed in the vector table in startup.c. */
+void UART0IntHandler( void );
+
+#endif
@@ -0,0 +1,278 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Input to pixel latency measurement as described in latency.h. */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "latency.h"
+#include "timestamp.h"
+#include "uartprint.h"
+
+/* One turn followed from the key press to the panel. */
+typedef struct xLATENCY_SAMPLE
+{
+	uint32_t ulTick;		/* changes.tick of the step that applied the turn. */
+	uint32_t ulReceived;
+	uint32_t ulApplied;
+	uint32_t ulPicked;
+} LatencySample_t;
+
+/*-----------------------------------------------------------*/
+
+/* Add one measurement to the statistics of a stage. */
+static void prvRecord( eLatencyStage eStage, uint32_t ulCycles );
+
+/*-----------------------------------------------------------*/
+
+/* Turns applied but not yet seen by the draw task, oldest first.  Written
+by the snake task and read by the draw task, so only accessed in critical
+sections. */
+static LatencySample_t xPending[ latencyMAX_PENDING ];
+static UBaseType_t uxPendingCount = 0;
+
+/* Turns picked up by the draw task whose frame has not yet been flushed.
+Only accessed by the draw task.  vLatencyReset() runs in the snake task, so
+rather than clearing them itself it sets xInFrameDiscard, and the draw task
+drops them the next time it picks up or flushes a frame. */
+static LatencySample_t xInFrame[ latencyMAX_PENDING ];
+static UBaseType_t uxInFrameCount = 0;
+static volatile BaseType_t xInFrameDiscard = pdFALSE;
+
+static LatencyStats_t xStats[ eLatencyStages ];
+static const uint32_t ulHistogramEdges[ latencyHISTOGRAM_BUCKETS - 1 ] = latencyHISTOGRAM_EDGES;
+
+static const char * const pcStageNames[ eLatencyStages ] =
+{
+	"key -> step",
+	"step -> draw",
+	"draw -> panel",
+	"key -> panel"
+};
+
+/*-----------------------------------------------------------*/
+
+void vLatencyReset( void )
+{
+	vTimestampInit();
+
+	taskENTER_CRITICAL();
+	{
+		uxPendingCount = 0;
+		xInFrameDiscard = pdTRUE;
+		memset( xStats, 0x00, sizeof( xStats ) );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyTurnApplied( uint32_t ulReceived, uint32_t ulTick )
+{
+LatencySample_t xSample;
+
+	xSample.ulTick = ulTick;
+	xSample.ulReceived = ulReceived;
+	xSample.ulApplied = ulTimestampGet();
+	xSample.ulPicked = 0;
+
+	taskENTER_CRITICAL();
+	{
+		/* If the draw task has fallen behind, drop the sample rather than
+		the key. */
+		if( uxPendingCount < latencyMAX_PENDING )
+		{
+			xPending[ uxPendingCount ] = xSample;
+			uxPendingCount++;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyFramePicked( uint32_t ulTick )
+{
+uint32_t ulNow;
+UBaseType_t uxIndex, uxPicked = 0;
+
+	ulNow = ulTimestampGet();
+
+	taskENTER_CRITICAL();
+	{
+		if( xInFrameDiscard != pdFALSE )
+		{
+			uxInFrameCount = 0;
+			xInFrameDiscard = pdFALSE;
+		}
+
+		/* Every pending turn applied at or before the snapshot's tick is in
+		this frame.  The signed difference copes with the tick wrapping. */
+		while( ( uxPicked < uxPendingCount ) &&
+			   ( ( int32_t ) ( ulTick - xPending[ uxPicked ].ulTick ) >= 0 ) &&
+			   ( uxInFrameCount < latencyMAX_PENDING ) )
+		{
+			xInFrame[ uxInFrameCount ] = xPending[ uxPicked ];
+			xInFrame[ uxInFrameCount ].ulPicked = ulNow;
+			uxInFrameCount++;
+			uxPicked++;
+		}
+
+		for( uxIndex = uxPicked; uxIndex < uxPendingCount; uxIndex++ )
+		{
+			xPending[ uxIndex - uxPicked ] = xPending[ uxIndex ];
+		}
+		uxPendingCount -= uxPicked;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyFrameFlushed( void )
+{
+uint32_t ulNow;
+UBaseType_t uxIndex;
+LatencySample_t *pxSample;
+
+	ulNow = ulTimestampGet();
+
+	/* Held across the loop so a reset cannot clear the statistics part way
+	through a frame and leave samples from the previous game in them. */
+	taskENTER_CRITICAL();
+	{
+		if( xInFrameDiscard == pdFALSE )
+		{
+			for( uxIndex = 0; uxIndex < uxInFrameCount; uxIndex++ )
+			{
+				pxSample = &xInFrame[ uxIndex ];
+				prvRecord( eLatencyApply, pxSample->ulApplied - pxSample->ulReceived );
+				prvRecord( eLatencyPickup, pxSample->ulPicked - pxSample->ulApplied );
+				prvRecord( eLatencyFlush, ulNow - pxSample->ulPicked );
+				prvRecord( eLatencyTotal, ulNow - pxSample->ulReceived );
+			}
+		}
+
+		uxInFrameCount = 0;
+		xInFrameDiscard = pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( eLatencyStage eStage, uint32_t ulCycles )
+{
+LatencyStats_t *pxStats = &xStats[ eStage ];
+uint32_t ulUs, ulBucket;
+
+	ulUs = timestampCYCLES_TO_US( ulCycles );
+
+	taskENTER_CRITICAL();
+	{
+		if( ( pxStats->ulSamples == 0 ) || ( ulUs < pxStats->ulMinUs ) )
+		{
+			pxStats->ulMinUs = ulUs;
+		}
+
+		if( ulUs > pxStats->ulMaxUs )
+		{
+			pxStats->ulMaxUs = ulUs;
+		}
+
+		pxStats->ulSamples++;
+		pxStats->ullTotalUs += ulUs;
+
+		for( ulBucket = 0; ulBucket < ( latencyHISTOGRAM_BUCKETS - 1 ); ulBucket++ )
+		{
+			if( ulUs < ulHistogramEdges[ ulBucket ] )
+			{
+				break;
+			}
+		}
+		pxStats->ulHistogram[ ulBucket ]++;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyStatsGet( eLatencyStage eStage, LatencyStats_t *pxStats )
+{
+	taskENTER_CRITICAL();
+	{
+		*pxStats = xStats[ eStage ];
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLatencyStatsPrint( void )
+{
+LatencyStats_t xCopy;
+eLatencyStage eStage;
+uint32_t ulBucket, ulAverage;
+
+	for( eStage = eLatencyApply; eStage < eLatencyStages; eStage++ )
+	{
+		vLatencyStatsGet( eStage, &xCopy );
+
+		ulAverage = ( xCopy.ulSamples > 0 ) ? ( uint32_t ) ( xCopy.ullTotalUs / xCopy.ulSamples ) : 0;
+
+		vUARTPrintf( "Latency %s: %u samples, us min %u avg %u max %u\r\n", pcStageNames[ eStage ],
+					 ( unsigned int ) xCopy.ulSamples, ( unsigned int ) xCopy.ulMinUs,
+					 ( unsigned int ) ulAverage, ( unsigned int ) xCopy.ulMaxUs );
+
+		/* Print only the buckets in use to keep the report short. */
+		for( ulBucket = 0; ulBucket < latencyHISTOGRAM_BUCKETS; ulBucket++ )
+		{
+			if( xCopy.ulHistogram[ ulBucket ] == 0 )
+			{
+				continue;
+			}
+
+			if( ulBucket == 0 )
+			{
+				vUARTPrintf( "  < %u: %u\r\n", ( unsigned int ) ulHistogramEdges[ 0 ],
+							 ( unsigned int ) xCopy.ulHistogram[ 0 ] );
+			}
+			else if( ulBucket == ( latencyHISTOGRAM_BUCKETS - 1 ) )
+			{
+				vUARTPrintf( "  >= %u: %u\r\n", ( unsigned int ) ulHistogramEdges[ ulBucket - 1 ],
+							 ( unsigned int ) xCopy.ulHistogram[ ulBucket ] );
+			}
+			else
+			{
+				vUARTPrintf( "  %u - %u: %u\r\n", ( unsigned int ) ulHistogramEdges[ ulBucket - 1 ],
+							 ( unsigned int ) ulHistogramEdges[ ulBucket ] - 1,
+							 ( unsigned int ) xCopy.ulHistogram[ ulBucket ] );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
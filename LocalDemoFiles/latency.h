@@ -0,0 +1,93 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+/*
+ * End to end latency of a key press, from the UART interrupt to the pixels
+ * on the panel.  Each turn that is applied is followed through four points,
+ * all read from the Timer 1 cycle counter (see timestamp.h):
+ *
+ *   received - the UART interrupt decoded the key (KeyMsg.ulTimestamp).
+ *   applied  - the snake task finished the game step that used the turn.
+ *   picked   - the draw task read a snapshot that includes that step.
+ *   flushed  - the SSI transfer of the frame drawn from that snapshot ended.
+ *
+ * The time taken by each stage, and by the whole path, is kept as
+ * min/avg/max and a histogram.  The statistics cover the samples since the
+ * last vLatencyReset(), which the game calls at the start of every game.
+ */
+
+/* The stages that are measured. */
+typedef enum
+{
+	eLatencyApply = 0,	/* received -> applied. */
+	eLatencyPickup,		/* applied -> picked. */
+	eLatencyFlush,		/* picked -> flushed. */
+	eLatencyTotal,		/* received -> flushed. */
+	eLatencyStages
+} eLatencyStage;
+
+/* The bucket edges of the histograms, in microseconds.  Bucket n counts
+latencies in the range [ edge n - 1, edge n ), and the last bucket counts
+everything slower. */
+#define latencyHISTOGRAM_EDGES		{ 100, 1000, 5000, 10000, 25000, 50000, 100000, 200000 }
+#define latencyHISTOGRAM_BUCKETS	( 9 )
+
+/* The number of applied turns that can be waiting for the draw task. */
+#define latencyMAX_PENDING			( 4 )
+
+typedef struct xLATENCY_STATS
+{
+	uint32_t ulSamples;
+	uint32_t ulMinUs;
+	uint32_t ulMaxUs;
+	uint64_t ullTotalUs;
+	uint32_t ulHistogram[ latencyHISTOGRAM_BUCKETS ];
+} LatencyStats_t;
+
+/* Discard any samples in flight and clear the statistics. */
+void vLatencyReset( void );
+
+/* Called by the snake task after the game step that applied a turn.
+ulReceived is the time the key was received, and ulTick the value of
+changes.tick after the step. */
+void vLatencyTurnApplied( uint32_t ulReceived, uint32_t ulTick );
+
+/* Called by the draw task when it reads a consistent snapshot, with the
+value of changes.tick in that snapshot. */
+void vLatencyFramePicked( uint32_t ulTick );
+
+/* Called by the draw task when the flush of the frame drawn from the
+snapshot has completed. */
+void vLatencyFrameFlushed( void );
+
+/* Access the statistics. */
+void vLatencyStatsGet( eLatencyStage eStage, LatencyStats_t *pxStats );
+void vLatencyStatsPrint( void );
+
+#endif
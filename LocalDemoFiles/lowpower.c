@@ -0,0 +1,213 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Low power idle support as described in lowpower.h. */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Library includes. */
+#include "hw_memmap.h"
+#include "hw_ssi.h"
+#include "hw_sysctl.h"
+#include "hw_types.h"
+#include "sysctl.h"
+
+/* Demo includes. */
+#include "lowpower.h"
+#include "timestamp.h"
+#include "uartprint.h"
+
+#define lowpowerCYCLES_PER_TICK		( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+/*-----------------------------------------------------------*/
+
+/* Gate the SSI clock during sleep unless a transfer is still in progress. */
+static void prvQuiesceSSI( void );
+
+/*-----------------------------------------------------------*/
+
+/* Counted from the tick interrupt and the idle task. */
+static volatile uint32_t ulTickInterrupts = 0;
+static uint32_t ulSleeps = 0;
+static uint32_t ulSSIAwake = 0;
+static uint64_t ullSleepCycles = 0;
+
+/* The tick count when the statistics were reset. */
+static TickType_t xResetTick = 0;
+
+/* Timer 1 count when the current sleep started. */
+static uint32_t ulSleepStart;
+
+/*-----------------------------------------------------------*/
+
+void vLowPowerInit( void )
+{
+	vTimestampInit();
+
+	/* While the CPU sleeps only the peripherals enabled here are clocked.
+	UART0 has to stay awake to receive keys, Timer 0 and Timer 1 are the game
+	clock and cycle counter, and the OLED control lines are on GPIO A and C.
+	SSI0 is decided before each sleep by prvQuiesceSSI(). */
+	SysCtlPeripheralSleepEnable( SYSCTL_PERIPH_UART0 );
+	SysCtlPeripheralSleepEnable( SYSCTL_PERIPH_TIMER0 );
+	SysCtlPeripheralSleepEnable( SYSCTL_PERIPH_TIMER1 );
+	SysCtlPeripheralSleepEnable( SYSCTL_PERIPH_GPIOA );
+	SysCtlPeripheralSleepEnable( SYSCTL_PERIPH_GPIOC );
+	SysCtlPeripheralSleepDisable( SYSCTL_PERIPH_SSI0 );
+	SysCtlPeripheralClockGating( true );
+
+	vLowPowerStatsReset();
+}
+/*-----------------------------------------------------------*/
+
+static void prvQuiesceSSI( void )
+{
+	/* The SSI registers can only be read once the display driver has turned
+	the peripheral on. */
+	if( ( HWREG( SYSCTL_RCGC1 ) & SYSCTL_RCGC1_SSI0 ) == 0 )
+	{
+		return;
+	}
+
+	/* A flush is driven by the SSI interrupt, which is raised when the FIFO
+	drains below half full.  If the SSI is still shifting data out it needs
+	its clock to get there, otherwise any further interrupt is already
+	pending and will end the sleep straight away. */
+	if( ( HWREG( SSI0_BASE + SSI_O_SR ) & SSI_SR_BSY ) != 0 )
+	{
+		SysCtlPeripheralSleepEnable( SYSCTL_PERIPH_SSI0 );
+		ulSSIAwake++;
+	}
+	else
+	{
+		SysCtlPeripheralSleepDisable( SYSCTL_PERIPH_SSI0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerPreSleep( TickType_t *pxExpectedIdleTime )
+{
+	/* Called with interrupts disabled, so nothing here can be preempted. */
+	( void ) pxExpectedIdleTime;
+
+	prvQuiesceSSI();
+	ulSleeps++;
+	ulSleepStart = ulTimestampGet();
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerPostSleep( TickType_t xExpectedIdleTime )
+{
+	( void ) xExpectedIdleTime;
+
+	ullSleepCycles += ulTimestampGet() - ulSleepStart;
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerIdle( void )
+{
+TickType_t xUnused = 0;
+
+	/* Disable interrupts so one cannot arrive between the hook and the WFI
+	and leave the CPU asleep with work to do.  A pending interrupt still ends
+	the WFI, and runs as soon as interrupts are enabled again. */
+	__asm volatile ( "cpsid i" ::: "memory" );
+	vLowPowerPreSleep( &xUnused );
+	__asm volatile ( "dsb" ::: "memory" );
+	__asm volatile ( "wfi" );
+	__asm volatile ( "isb" );
+	vLowPowerPostSleep( xUnused );
+	__asm volatile ( "cpsie i" ::: "memory" );
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerTickHook( void )
+{
+	ulTickInterrupts++;
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerStatsGet( LowPowerStats_t *pxStats )
+{
+TickType_t xTicks;
+
+	taskENTER_CRITICAL();
+	{
+		xTicks = xTaskGetTickCount() - xResetTick;
+
+		pxStats->ulTicks = ( uint32_t ) xTicks;
+		pxStats->ulTickInterrupts = ulTickInterrupts;
+		pxStats->ulSleeps = ulSleeps;
+		pxStats->ulSSIAwake = ulSSIAwake;
+		pxStats->ullSleepCycles = ullSleepCycles;
+		pxStats->ullElapsedCycles = ( uint64_t ) xTicks * lowpowerCYCLES_PER_TICK;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerStatsReset( void )
+{
+	taskENTER_CRITICAL();
+	{
+		xResetTick = xTaskGetTickCount();
+		ulTickInterrupts = 0;
+		ulSleeps = 0;
+		ulSSIAwake = 0;
+		ullSleepCycles = 0;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLowPowerStatsPrint( void )
+{
+LowPowerStats_t xCopy;
+uint32_t ulSuppressed, ulPermille = 0;
+
+	vLowPowerStatsGet( &xCopy );
+
+	ulSuppressed = ( xCopy.ulTicks > xCopy.ulTickInterrupts ) ? ( xCopy.ulTicks - xCopy.ulTickInterrupts ) : 0;
+
+	if( xCopy.ullElapsedCycles > 0 )
+	{
+		ulPermille = ( uint32_t ) ( ( xCopy.ullSleepCycles * 1000ULL ) / xCopy.ullElapsedCycles );
+	}
+
+	vUARTPrintf( "Idle: %u ticks, %u tick interrupts, %u suppressed, %u sleeps (%u with SSI clocked)\r\n",
+				 ( unsigned int ) xCopy.ulTicks, ( unsigned int ) xCopy.ulTickInterrupts,
+				 ( unsigned int ) ulSuppressed, ( unsigned int ) xCopy.ulSleeps,
+				 ( unsigned int ) xCopy.ulSSIAwake );
+	vUARTPrintf( "  asleep %u.%u%% of the time\r\n",
+				 ( unsigned int ) ( ulPermille / 10 ), ( unsigned int ) ( ulPermille % 10 ) );
+}
+/*-----------------------------------------------------------*/
+
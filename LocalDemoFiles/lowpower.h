@@ -0,0 +1,73 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+/*
+ * Low power idle support.  With configUSE_TICKLESS_IDLE set (the default,
+ * see FreeRTOSConfig.h) the kernel stops the tick while every task is
+ * blocked and the port layer sleeps with WFI until the next task is due or an
+ * interrupt arrives.  vLowPowerPreSleep() and vLowPowerPostSleep() are
+ * called either side of the WFI through configPRE_SLEEP_PROCESSING() and
+ * configPOST_SLEEP_PROCESSING().  Without tickless idle the idle hook sleeps
+ * with WFI until the next interrupt instead, which is at most one tick away.
+ *
+ * The statistics show how often the CPU was woken and how much of the time
+ * it spent asleep.  Ticks that passed without a tick interrupt are counted
+ * as suppressed.  Under QEMU run with -icount so that time spent asleep is
+ * not counted as executed instructions.
+ */
+
+typedef struct xLOW_POWER_STATS
+{
+	uint32_t ulTicks;				/* RTOS ticks elapsed. */
+	uint32_t ulTickInterrupts;		/* Tick interrupts that actually ran. */
+	uint32_t ulSleeps;				/* Times the idle task entered WFI. */
+	uint32_t ulSSIAwake;			/* Sleeps for which SSI was left clocked to finish a transfer. */
+	uint64_t ullSleepCycles;		/* CPU cycles spent in WFI. */
+	uint64_t ullElapsedCycles;		/* CPU cycles elapsed. */
+} LowPowerStats_t;
+
+/* Select the peripherals that keep their clocks while the CPU sleeps. */
+void vLowPowerInit( void );
+
+/* Sleep hooks, see FreeRTOSConfig.h. */
+void vLowPowerPreSleep( TickType_t *pxExpectedIdleTime );
+void vLowPowerPostSleep( TickType_t xExpectedIdleTime );
+
+/* Called from the idle hook when tickless idle is not used. */
+void vLowPowerIdle( void );
+
+/* Called from the tick hook to count tick interrupts. */
+void vLowPowerTickHook( void );
+
+/* Access the statistics, which cover the time since the last reset. */
+void vLowPowerStatsGet( LowPowerStats_t *pxStats );
+void vLowPowerStatsReset( void );
+void vLowPowerStatsPrint( void );
+
+#endif
@@ -40,8 +40,24 @@
 #include "gpio.h"
 #include "ssi.h"
 #include "sysctl.h"
+#include "grlib.h"
 #include "osram128x64x4.h"
 
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hw_ints.h"
+#include "interrupt.h"
+
+//*****************************************************************************
+//
+// When set, frame buffer flushes are driven by the SSI0 interrupt once the
+// scheduler is running, instead of busy-waiting on the SSI port.
+//
+//*****************************************************************************
+#ifndef OSRAM_USE_INTERRUPTS
+#define OSRAM_USE_INTERRUPTS    1
+#endif
+
 //*****************************************************************************
 //
 // Flag to indicate if SSI port is enabled for OSRAM usage.
@@ -83,6 +99,106 @@ static volatile tBoolean g_bSSIEnabled = false;
 static const unsigned char g_pucOSRAM128x64x4VerticalInc[]   = { 0xA0, 0x56 };
 static const unsigned char g_pucOSRAM128x64x4HorizontalInc[] = { 0xA0, 0x52 };
 
+//*****************************************************************************
+//
+// The off-screen frame buffer.  It uses the same layout as the display RAM
+// in horizontal address increment mode: 64 rows of 64 bytes, each byte
+// holding two pixels with the leftmost pixel in bits 7:4.
+//
+//*****************************************************************************
+#define OSRAM_FRAME_COLUMNS 64
+#define OSRAM_FRAME_ROWS    64
+static unsigned char g_pucOSRAMFrame[OSRAM_FRAME_ROWS][OSRAM_FRAME_COLUMNS];
+
+//*****************************************************************************
+//
+// The list of frame buffer regions that differ from the display RAM.  Each
+// rectangle is specified in byte columns and rows, with inclusive bounds.
+//
+// Every rectangle costs a window setup (column, row and re-map commands) when
+// it is flushed, so two rectangles are merged whenever sending their bounding
+// box would not cost more bytes than sending both of them separately.
+//
+//*****************************************************************************
+#define OSRAM_DIRTY_RECTS   8
+#define OSRAM_WINDOW_COST   8
+
+typedef struct
+{
+    unsigned char ucX0;
+    unsigned char ucY0;
+    unsigned char ucX1;
+    unsigned char ucY1;
+}
+tOSRAMRect;
+
+static tOSRAMRect g_psOSRAMDirty[OSRAM_DIRTY_RECTS];
+static unsigned long g_ulOSRAMDirtyCount = 0;
+
+//*****************************************************************************
+//
+// A flush is described as a list of segments, each being a block of bytes
+// sent with the D/C signal at one level.  A segment covers ucRows rows of
+// ucWidth bytes, with consecutive rows ucStride bytes apart, so a dirty region
+// can be sent straight out of the frame buffer.  Every dirty region needs a
+// command segment to open its window, followed by a data segment.
+//
+//*****************************************************************************
+typedef struct
+{
+    const unsigned char *pucData;
+    unsigned char ucWidth;
+    unsigned char ucRows;
+    unsigned char ucStride;
+    tBoolean bData;
+}
+tOSRAMSegment;
+
+static tOSRAMSegment g_psOSRAMSegment[OSRAM_DIRTY_RECTS * 2];
+static unsigned char g_pucOSRAMFlushCommand[OSRAM_DIRTY_RECTS][OSRAM_WINDOW_COST];
+
+//*****************************************************************************
+//
+// A shadow of the controller's addressing state: the column and row windows,
+// the re-map setting and the address the next data byte will be written to.
+// Commands that would not change this state are not sent.  The level of the
+// D/C signal is tracked too, so it is only written when it changes.
+//
+//*****************************************************************************
+#define OSRAM_REMAP_VERTICAL    0x04
+
+typedef struct
+{
+    tBoolean bValid;
+    unsigned char ucColumnStart;
+    unsigned char ucColumnEnd;
+    unsigned char ucRowStart;
+    unsigned char ucRowEnd;
+    unsigned char ucColumn;
+    unsigned char ucRow;
+    unsigned char ucRemap;
+}
+tOSRAMAddressState;
+
+static tOSRAMAddressState g_sOSRAMAddress;
+static tBoolean g_bOSRAMDataModeKnown = false;
+static tBoolean g_bOSRAMDataMode;
+
+#if OSRAM_USE_INTERRUPTS
+//*****************************************************************************
+//
+// The state of the interrupt driven transfer.  g_ulOSRAMSegmentCount is
+// non-zero while the interrupt handler owns the segment list.
+//
+//*****************************************************************************
+static volatile unsigned long g_ulOSRAMSegmentCount = 0;
+static unsigned long g_ulOSRAMSegmentIdx;
+static unsigned long g_ulOSRAMRow;
+static unsigned long g_ulOSRAMColumn;
+static TaskHandle_t g_xOSRAMFlushTask;
+static volatile tBoolean g_bOSRAMFlushBusy = false;
+#endif
+
 //*****************************************************************************
 //
 // A 5x7 font (in a 6x8 cell, where the sixth column is omitted from this
@@ -91,109 +207,167 @@ static const unsigned char g_pucOSRAM128x64x4HorizontalInc[] = { 0xA0, 0x52 };
 // the top row in the LSB and the bottom row in the MSB.
 //
 // Note:  This is the same font data that is used in the EK-LM3S811
-// osram96x16x1 driver.  The single bit-per-pixel is expaned in the StringDraw
-// function to the appropriate four bit-per-pixel gray scale format.
+// osram96x16x1 driver.  The single bit-per-pixel is expaned to the
+// appropriate four bit-per-pixel gray scale format either at compile time
+// (see g_pucOSRAMGlyphs below) or by the string drawing functions.
+//
+// The table is written as a list of X(...) entries so that it can be
+// expanded into either format.
+//
+//*****************************************************************************
+#define OSRAM_FONT(X)                                                         \
+    X(0x00, 0x00, 0x00, 0x00, 0x00) /* " " */ \
+    X(0x00, 0x00, 0x4f, 0x00, 0x00) /* ! */   \
+    X(0x00, 0x07, 0x00, 0x07, 0x00) /* " */   \
+    X(0x14, 0x7f, 0x14, 0x7f, 0x14) /* # */   \
+    X(0x24, 0x2a, 0x7f, 0x2a, 0x12) /* $ */   \
+    X(0x23, 0x13, 0x08, 0x64, 0x62) /* % */   \
+    X(0x36, 0x49, 0x55, 0x22, 0x50) /* & */   \
+    X(0x00, 0x05, 0x03, 0x00, 0x00) /* ' */   \
+    X(0x00, 0x1c, 0x22, 0x41, 0x00) /* ( */   \
+    X(0x00, 0x41, 0x22, 0x1c, 0x00) /* ) */   \
+    X(0x14, 0x08, 0x3e, 0x08, 0x14) /* * */   \
+    X(0x08, 0x08, 0x3e, 0x08, 0x08) /* + */   \
+    X(0x00, 0x50, 0x30, 0x00, 0x00) /* , */   \
+    X(0x08, 0x08, 0x08, 0x08, 0x08) /* - */   \
+    X(0x00, 0x60, 0x60, 0x00, 0x00) /* . */   \
+    X(0x20, 0x10, 0x08, 0x04, 0x02) /* / */   \
+    X(0x3e, 0x51, 0x49, 0x45, 0x3e) /* 0 */   \
+    X(0x00, 0x42, 0x7f, 0x40, 0x00) /* 1 */   \
+    X(0x42, 0x61, 0x51, 0x49, 0x46) /* 2 */   \
+    X(0x21, 0x41, 0x45, 0x4b, 0x31) /* 3 */   \
+    X(0x18, 0x14, 0x12, 0x7f, 0x10) /* 4 */   \
+    X(0x27, 0x45, 0x45, 0x45, 0x39) /* 5 */   \
+    X(0x3c, 0x4a, 0x49, 0x49, 0x30) /* 6 */   \
+    X(0x01, 0x71, 0x09, 0x05, 0x03) /* 7 */   \
+    X(0x36, 0x49, 0x49, 0x49, 0x36) /* 8 */   \
+    X(0x06, 0x49, 0x49, 0x29, 0x1e) /* 9 */   \
+    X(0x00, 0x36, 0x36, 0x00, 0x00) /* : */   \
+    X(0x00, 0x56, 0x36, 0x00, 0x00) /* ; */   \
+    X(0x08, 0x14, 0x22, 0x41, 0x00) /* < */   \
+    X(0x14, 0x14, 0x14, 0x14, 0x14) /* = */   \
+    X(0x00, 0x41, 0x22, 0x14, 0x08) /* > */   \
+    X(0x02, 0x01, 0x51, 0x09, 0x06) /* ? */   \
+    X(0x32, 0x49, 0x79, 0x41, 0x3e) /* @ */   \
+    X(0x7e, 0x11, 0x11, 0x11, 0x7e) /* A */   \
+    X(0x7f, 0x49, 0x49, 0x49, 0x36) /* B */   \
+    X(0x3e, 0x41, 0x41, 0x41, 0x22) /* C */   \
+    X(0x7f, 0x41, 0x41, 0x22, 0x1c) /* D */   \
+    X(0x7f, 0x49, 0x49, 0x49, 0x41) /* E */   \
+    X(0x7f, 0x09, 0x09, 0x09, 0x01) /* F */   \
+    X(0x3e, 0x41, 0x49, 0x49, 0x7a) /* G */   \
+    X(0x7f, 0x08, 0x08, 0x08, 0x7f) /* H */   \
+    X(0x00, 0x41, 0x7f, 0x41, 0x00) /* I */   \
+    X(0x20, 0x40, 0x41, 0x3f, 0x01) /* J */   \
+    X(0x7f, 0x08, 0x14, 0x22, 0x41) /* K */   \
+    X(0x7f, 0x40, 0x40, 0x40, 0x40) /* L */   \
+    X(0x7f, 0x02, 0x0c, 0x02, 0x7f) /* M */   \
+    X(0x7f, 0x04, 0x08, 0x10, 0x7f) /* N */   \
+    X(0x3e, 0x41, 0x41, 0x41, 0x3e) /* O */   \
+    X(0x7f, 0x09, 0x09, 0x09, 0x06) /* P */   \
+    X(0x3e, 0x41, 0x51, 0x21, 0x5e) /* Q */   \
+    X(0x7f, 0x09, 0x19, 0x29, 0x46) /* R */   \
+    X(0x46, 0x49, 0x49, 0x49, 0x31) /* S */   \
+    X(0x01, 0x01, 0x7f, 0x01, 0x01) /* T */   \
+    X(0x3f, 0x40, 0x40, 0x40, 0x3f) /* U */   \
+    X(0x1f, 0x20, 0x40, 0x20, 0x1f) /* V */   \
+    X(0x3f, 0x40, 0x38, 0x40, 0x3f) /* W */   \
+    X(0x63, 0x14, 0x08, 0x14, 0x63) /* X */   \
+    X(0x07, 0x08, 0x70, 0x08, 0x07) /* Y */   \
+    X(0x61, 0x51, 0x49, 0x45, 0x43) /* Z */   \
+    X(0x00, 0x7f, 0x41, 0x41, 0x00) /* [ */   \
+    X(0x02, 0x04, 0x08, 0x10, 0x20) /* "\" */ \
+    X(0x00, 0x41, 0x41, 0x7f, 0x00) /* ] */   \
+    X(0x04, 0x02, 0x01, 0x02, 0x04) /* ^ */   \
+    X(0x40, 0x40, 0x40, 0x40, 0x40) /* _ */   \
+    X(0x00, 0x01, 0x02, 0x04, 0x00) /* ` */   \
+    X(0x20, 0x54, 0x54, 0x54, 0x78) /* a */   \
+    X(0x7f, 0x48, 0x44, 0x44, 0x38) /* b */   \
+    X(0x38, 0x44, 0x44, 0x44, 0x20) /* c */   \
+    X(0x38, 0x44, 0x44, 0x48, 0x7f) /* d */   \
+    X(0x38, 0x54, 0x54, 0x54, 0x18) /* e */   \
+    X(0x08, 0x7e, 0x09, 0x01, 0x02) /* f */   \
+    X(0x0c, 0x52, 0x52, 0x52, 0x3e) /* g */   \
+    X(0x7f, 0x08, 0x04, 0x04, 0x78) /* h */   \
+    X(0x00, 0x44, 0x7d, 0x40, 0x00) /* i */   \
+    X(0x20, 0x40, 0x44, 0x3d, 0x00) /* j */   \
+    X(0x7f, 0x10, 0x28, 0x44, 0x00) /* k */   \
+    X(0x00, 0x41, 0x7f, 0x40, 0x00) /* l */   \
+    X(0x7c, 0x04, 0x18, 0x04, 0x78) /* m */   \
+    X(0x7c, 0x08, 0x04, 0x04, 0x78) /* n */   \
+    X(0x38, 0x44, 0x44, 0x44, 0x38) /* o */   \
+    X(0x7c, 0x14, 0x14, 0x14, 0x08) /* p */   \
+    X(0x08, 0x14, 0x14, 0x18, 0x7c) /* q */   \
+    X(0x7c, 0x08, 0x04, 0x04, 0x08) /* r */   \
+    X(0x48, 0x54, 0x54, 0x54, 0x20) /* s */   \
+    X(0x04, 0x3f, 0x44, 0x40, 0x20) /* t */   \
+    X(0x3c, 0x40, 0x40, 0x20, 0x7c) /* u */   \
+    X(0x1c, 0x20, 0x40, 0x20, 0x1c) /* v */   \
+    X(0x3c, 0x40, 0x30, 0x40, 0x3c) /* w */   \
+    X(0x44, 0x28, 0x10, 0x28, 0x44) /* x */   \
+    X(0x0c, 0x50, 0x50, 0x50, 0x3c) /* y */   \
+    X(0x44, 0x64, 0x54, 0x4c, 0x44) /* z */   \
+    X(0x00, 0x08, 0x36, 0x41, 0x00) /* { */   \
+    X(0x00, 0x00, 0x7f, 0x00, 0x00) /* | */   \
+    X(0x00, 0x41, 0x36, 0x08, 0x00) /* } */   \
+    X(0x02, 0x01, 0x02, 0x04, 0x02) /* ~ */   \
+    X(0x02, 0x01, 0x02, 0x04, 0x02) /* ~ */   \
+
+#if OSRAM_USE_GLYPH_ATLAS || OSRAM_COMPARE_GLYPH_PATHS
+//*****************************************************************************
+//
+// The font expanded into the native format of the display RAM.  Each
+// character is three byte columns of eight rows, in the order they are sent
+// in vertical address increment mode, with every lit pixel at full
+// brightness.  Any other grey level is obtained by masking each byte with the
+// level replicated into both nibbles.  The compiler builds the table from the
+// font data, so nothing is expanded at run time.
 //
 //*****************************************************************************
+#define OSRAM_GLYPH_PIXELS(ucLeft, ucRight, ulRow)                            \
+    (((((ucLeft) >> (ulRow)) & 1) ? 0xf0 : 0) |                               \
+     ((((ucRight) >> (ulRow)) & 1) ? 0x0f : 0))
+#define OSRAM_GLYPH_COLUMN(ucLeft, ucRight)                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 0),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 1),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 2),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 3),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 4),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 5),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 6),                                   \
+    OSRAM_GLYPH_PIXELS(ucLeft, ucRight, 7)
+#define OSRAM_GLYPH(uc0, uc1, uc2, uc3, uc4)                                  \
+    {                                                                         \
+        OSRAM_GLYPH_COLUMN(uc0, uc1),                                         \
+        OSRAM_GLYPH_COLUMN(uc2, uc3),                                         \
+        OSRAM_GLYPH_COLUMN(uc4, 0)                                            \
+    },
+
+static const unsigned char g_pucOSRAMGlyphs[96][24] =
+{
+    OSRAM_FONT(OSRAM_GLYPH)
+};
+#endif
+
+#if !OSRAM_USE_GLYPH_ATLAS || OSRAM_COMPARE_GLYPH_PATHS
+#define OSRAM_FONT_ENTRY(uc0, uc1, uc2, uc3, uc4)                             \
+    { uc0, uc1, uc2, uc3, uc4 },
+
 static const unsigned char g_pucFont[96][5] =
 {
-    { 0x00, 0x00, 0x00, 0x00, 0x00 }, // " "
-    { 0x00, 0x00, 0x4f, 0x00, 0x00 }, // !
-    { 0x00, 0x07, 0x00, 0x07, 0x00 }, // "
-    { 0x14, 0x7f, 0x14, 0x7f, 0x14 }, // #
-    { 0x24, 0x2a, 0x7f, 0x2a, 0x12 }, // $
-    { 0x23, 0x13, 0x08, 0x64, 0x62 }, // %
-    { 0x36, 0x49, 0x55, 0x22, 0x50 }, // &
-    { 0x00, 0x05, 0x03, 0x00, 0x00 }, // '
-    { 0x00, 0x1c, 0x22, 0x41, 0x00 }, // (
-    { 0x00, 0x41, 0x22, 0x1c, 0x00 }, // )
-    { 0x14, 0x08, 0x3e, 0x08, 0x14 }, // *
-    { 0x08, 0x08, 0x3e, 0x08, 0x08 }, // +
-    { 0x00, 0x50, 0x30, 0x00, 0x00 }, // ,
-    { 0x08, 0x08, 0x08, 0x08, 0x08 }, // -
-    { 0x00, 0x60, 0x60, 0x00, 0x00 }, // .
-    { 0x20, 0x10, 0x08, 0x04, 0x02 }, // /
-    { 0x3e, 0x51, 0x49, 0x45, 0x3e }, // 0
-    { 0x00, 0x42, 0x7f, 0x40, 0x00 }, // 1
-    { 0x42, 0x61, 0x51, 0x49, 0x46 }, // 2
-    { 0x21, 0x41, 0x45, 0x4b, 0x31 }, // 3
-    { 0x18, 0x14, 0x12, 0x7f, 0x10 }, // 4
-    { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 5
-    { 0x3c, 0x4a, 0x49, 0x49, 0x30 }, // 6
-    { 0x01, 0x71, 0x09, 0x05, 0x03 }, // 7
-    { 0x36, 0x49, 0x49, 0x49, 0x36 }, // 8
-    { 0x06, 0x49, 0x49, 0x29, 0x1e }, // 9
-    { 0x00, 0x36, 0x36, 0x00, 0x00 }, // :
-    { 0x00, 0x56, 0x36, 0x00, 0x00 }, // ;
-    { 0x08, 0x14, 0x22, 0x41, 0x00 }, // <
-    { 0x14, 0x14, 0x14, 0x14, 0x14 }, // =
-    { 0x00, 0x41, 0x22, 0x14, 0x08 }, // >
-    { 0x02, 0x01, 0x51, 0x09, 0x06 }, // ?
-    { 0x32, 0x49, 0x79, 0x41, 0x3e }, // @
-    { 0x7e, 0x11, 0x11, 0x11, 0x7e }, // A
-    { 0x7f, 0x49, 0x49, 0x49, 0x36 }, // B
-    { 0x3e, 0x41, 0x41, 0x41, 0x22 }, // C
-    { 0x7f, 0x41, 0x41, 0x22, 0x1c }, // D
-    { 0x7f, 0x49, 0x49, 0x49, 0x41 }, // E
-    { 0x7f, 0x09, 0x09, 0x09, 0x01 }, // F
-    { 0x3e, 0x41, 0x49, 0x49, 0x7a }, // G
-    { 0x7f, 0x08, 0x08, 0x08, 0x7f }, // H
-    { 0x00, 0x41, 0x7f, 0x41, 0x00 }, // I
-    { 0x20, 0x40, 0x41, 0x3f, 0x01 }, // J
-    { 0x7f, 0x08, 0x14, 0x22, 0x41 }, // K
-    { 0x7f, 0x40, 0x40, 0x40, 0x40 }, // L
-    { 0x7f, 0x02, 0x0c, 0x02, 0x7f }, // M
-    { 0x7f, 0x04, 0x08, 0x10, 0x7f }, // N
-    { 0x3e, 0x41, 0x41, 0x41, 0x3e }, // O
-    { 0x7f, 0x09, 0x09, 0x09, 0x06 }, // P
-    { 0x3e, 0x41, 0x51, 0x21, 0x5e }, // Q
-    { 0x7f, 0x09, 0x19, 0x29, 0x46 }, // R
-    { 0x46, 0x49, 0x49, 0x49, 0x31 }, // S
-    { 0x01, 0x01, 0x7f, 0x01, 0x01 }, // T
-    { 0x3f, 0x40, 0x40, 0x40, 0x3f }, // U
-    { 0x1f, 0x20, 0x40, 0x20, 0x1f }, // V
-    { 0x3f, 0x40, 0x38, 0x40, 0x3f }, // W
-    { 0x63, 0x14, 0x08, 0x14, 0x63 }, // X
-    { 0x07, 0x08, 0x70, 0x08, 0x07 }, // Y
-    { 0x61, 0x51, 0x49, 0x45, 0x43 }, // Z
-    { 0x00, 0x7f, 0x41, 0x41, 0x00 }, // [
-    { 0x02, 0x04, 0x08, 0x10, 0x20 }, // "\"
-    { 0x00, 0x41, 0x41, 0x7f, 0x00 }, // ]
-    { 0x04, 0x02, 0x01, 0x02, 0x04 }, // ^
-    { 0x40, 0x40, 0x40, 0x40, 0x40 }, // _
-    { 0x00, 0x01, 0x02, 0x04, 0x00 }, // `
-    { 0x20, 0x54, 0x54, 0x54, 0x78 }, // a
-    { 0x7f, 0x48, 0x44, 0x44, 0x38 }, // b
-    { 0x38, 0x44, 0x44, 0x44, 0x20 }, // c
-    { 0x38, 0x44, 0x44, 0x48, 0x7f }, // d
-    { 0x38, 0x54, 0x54, 0x54, 0x18 }, // e
-    { 0x08, 0x7e, 0x09, 0x01, 0x02 }, // f
-    { 0x0c, 0x52, 0x52, 0x52, 0x3e }, // g
-    { 0x7f, 0x08, 0x04, 0x04, 0x78 }, // h
-    { 0x00, 0x44, 0x7d, 0x40, 0x00 }, // i
-    { 0x20, 0x40, 0x44, 0x3d, 0x00 }, // j
-    { 0x7f, 0x10, 0x28, 0x44, 0x00 }, // k
-    { 0x00, 0x41, 0x7f, 0x40, 0x00 }, // l
-    { 0x7c, 0x04, 0x18, 0x04, 0x78 }, // m
-    { 0x7c, 0x08, 0x04, 0x04, 0x78 }, // n
-    { 0x38, 0x44, 0x44, 0x44, 0x38 }, // o
-    { 0x7c, 0x14, 0x14, 0x14, 0x08 }, // p
-    { 0x08, 0x14, 0x14, 0x18, 0x7c }, // q
-    { 0x7c, 0x08, 0x04, 0x04, 0x08 }, // r
-    { 0x48, 0x54, 0x54, 0x54, 0x20 }, // s
-    { 0x04, 0x3f, 0x44, 0x40, 0x20 }, // t
-    { 0x3c, 0x40, 0x40, 0x20, 0x7c }, // u
-    { 0x1c, 0x20, 0x40, 0x20, 0x1c }, // v
-    { 0x3c, 0x40, 0x30, 0x40, 0x3c }, // w
-    { 0x44, 0x28, 0x10, 0x28, 0x44 }, // x
-    { 0x0c, 0x50, 0x50, 0x50, 0x3c }, // y
-    { 0x44, 0x64, 0x54, 0x4c, 0x44 }, // z
-    { 0x00, 0x08, 0x36, 0x41, 0x00 }, // {
-    { 0x00, 0x00, 0x7f, 0x00, 0x00 }, // |
-    { 0x00, 0x41, 0x36, 0x08, 0x00 }, // }
-    { 0x02, 0x01, 0x02, 0x04, 0x02 }, // ~
-    { 0x02, 0x01, 0x02, 0x04, 0x02 }, // ~
+    OSRAM_FONT(OSRAM_FONT_ENTRY)
 };
+#endif
+
+#if OSRAM_COMPARE_GLYPH_PATHS
+//*****************************************************************************
+//
+// Selects the glyph table or the 1-bit font expansion for the string drawing
+// functions, set by OSRAM128x64x4GlyphAtlasEnable().
+//
+//*****************************************************************************
+static tBoolean g_bOSRAMUseGlyphAtlas = OSRAM_USE_GLYPH_ATLAS;
+#endif
 
 //*****************************************************************************
 //
@@ -295,6 +469,79 @@ static const unsigned char g_pucOSRAM128x64x4Init[] =
     2, 0xAF, 0xe3,
 };
 
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Sets the level of the D/C signal, unless it is already at that level.
+//!
+//! \param bData is \b true to select data mode and \b false to select
+//! command mode.
+//!
+//! The controller samples the D/C signal with every byte, so this must only be
+//! called while the SSI port is idle.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAMSetDataMode(tBoolean bData)
+{
+    if(!g_bOSRAMDataModeKnown || (g_bOSRAMDataMode != bData))
+    {
+        GPIOPinWrite(GPIO_PORTC_BASE, GPIO_PIN_7, bData ? GPIO_PIN_7 : 0);
+        g_bOSRAMDataMode = bData;
+        g_bOSRAMDataModeKnown = true;
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Advances the shadow address pointer past a number of data bytes.
+//!
+//! \param ulCount is the number of data bytes written to the display RAM.
+//!
+//! The address pointer moves through the current window along rows or columns
+//! depending on the re-map setting, wrapping back to the start of the window
+//! after its last byte.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAMAddressAdvance(unsigned long ulCount)
+{
+    tOSRAMAddressState *psState = &g_sOSRAMAddress;
+    unsigned long ulWidth, ulHeight, ulIdx;
+
+    if(!psState->bValid)
+    {
+        return;
+    }
+
+    ulWidth = psState->ucColumnEnd - psState->ucColumnStart + 1;
+    ulHeight = psState->ucRowEnd - psState->ucRowStart + 1;
+
+    if(psState->ucRemap & OSRAM_REMAP_VERTICAL)
+    {
+        ulIdx = (((psState->ucColumn - psState->ucColumnStart) * ulHeight) +
+                 (psState->ucRow - psState->ucRowStart) + ulCount) %
+                (ulWidth * ulHeight);
+        psState->ucColumn = psState->ucColumnStart + (ulIdx / ulHeight);
+        psState->ucRow = psState->ucRowStart + (ulIdx % ulHeight);
+    }
+    else
+    {
+        ulIdx = (((psState->ucRow - psState->ucRowStart) * ulWidth) +
+                 (psState->ucColumn - psState->ucColumnStart) + ulCount) %
+                (ulWidth * ulHeight);
+        psState->ucRow = psState->ucRowStart + (ulIdx / ulWidth);
+        psState->ucColumn = psState->ucColumnStart + (ulIdx % ulWidth);
+    }
+}
+
 //*****************************************************************************
 //
 //! \internal
@@ -323,7 +570,7 @@ OSRAMWriteCommand(const unsigned char *pucBuffer, unsigned long ulCount)
     //
     // Clear the command/control bit to enable command mode.
     //
-    GPIOPinWrite(GPIO_PORTC_BASE, GPIO_PIN_7, 0);
+    OSRAMSetDataMode(false);
 
     //
     // Loop while there are more bytes left to be transferred.
@@ -375,7 +622,8 @@ OSRAMWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
     //
     // Set the command/control bit to enable data mode.
     //
-    GPIOPinWrite(GPIO_PORTC_BASE, GPIO_PIN_7, GPIO_PIN_7);
+    OSRAMSetDataMode(true);
+    OSRAMAddressAdvance(ulCount);
 
     //
     // Loop while there are more bytes left to be transferred.
@@ -401,195 +649,438 @@ OSRAMWriteData(const unsigned char *pucBuffer, unsigned long ulCount)
 
 //*****************************************************************************
 //
-//! Clears the OLED display.
+//! \internal
 //!
-//! This function will clear the display RAM.  All pixels in the display will
-//! be turned off.
+//! Write a run of identical data bytes to the SSD0323 controller.
 //!
-//! This function is contained in <tt>osram128x64x4.c</tt>, with
-//! <tt>osram128x64x4.h</tt> containing the API definition for use by
-//! applications.
+//! This sends \e ulCount copies of \e ucValue as a single burst, without
+//! needing a buffer holding them.  The data is written in a polled fashion.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-OSRAM128x64x4Clear(void)
+static void
+OSRAMWriteDataFill(unsigned char ucValue, unsigned long ulCount)
 {
-    static const unsigned char pucCommand1[] = { 0x15, 0, 63 };
-    static const unsigned char pucCommand2[] = { 0x75, 0, 79 };
-    unsigned long ulRow, ulColumn;
-    static unsigned char pucZeroBuffer[8] = { 0, 0, 0, 0, 0, 0, 0, 0};
+    unsigned long ulTemp;
 
     //
-    // Set the window to fill the entire display.
+    // Return iff SSI port is not enabled for OSRAM.
     //
-    OSRAMWriteCommand(pucCommand1, sizeof(pucCommand1));
-    OSRAMWriteCommand(pucCommand2, sizeof(pucCommand2));
-    OSRAMWriteCommand(g_pucOSRAM128x64x4VerticalInc,
-                      sizeof(g_pucOSRAM128x64x4VerticalInc));
+    if(!g_bSSIEnabled)
+    {
+        return;
+    }
 
-    //
-    // In vertical address increment mode, loop through each column, filling
-    // each row with 0.
-    //
-    for(ulColumn = 0; ulColumn < (128/2); ulColumn++)
+    OSRAMSetDataMode(true);
+    OSRAMAddressAdvance(ulCount);
+
+    while(ulCount != 0)
     {
-        //
-        // 8 rows (bytes) per row of text.
-        //
-        for(ulRow = 0; ulRow < 80; ulRow += 8)
-        {
-            OSRAMWriteData(pucZeroBuffer, sizeof(pucZeroBuffer));
-        }
+        SSIDataPut(SSI0_BASE, ucValue);
+        SSIDataGet(SSI0_BASE, &ulTemp);
+        ulCount--;
     }
 }
 
 //*****************************************************************************
 //
-//! Displays a string on the OLED display.
+//! \internal
 //!
-//! \param pcStr is a pointer to the string to display.
-//! \param ulX is the horizontal position to display the string, specified in
-//! columns from the left edge of the display.
-//! \param ulY is the vertical position to display the string, specified in
-//! rows from the top edge of the display.
-//! \param ucLevel is the 4-bit grey scale value to be used for displayed text.
+//! Builds the commands needed to open a window in the display RAM.
 //!
-//! This function will draw a string on the display.  Only the ASCII characters
-//! between 32 (space) and 126 (tilde) are supported; other characters will
-//! result in random data being draw on the display (based on whatever appears
-//! before/after the font in memory).  The font is mono-spaced, so characters
-//! such as "i" and "l" have more white space around them than characters such
-//! as "m" or "w".
+//! \param ulX0 is the first column of the window, in bytes.
+//! \param ulX1 is the last column of the window, in bytes.
+//! \param ulY0 is the first row of the window.
+//! \param ulY1 is the last row of the window.
+//! \param ucRemap is the re-map setting selecting the address increment.
+//! \param pucBuffer receives the command bytes; it must hold eight bytes.
 //!
-//! If the drawing of the string reaches the right edge of the display, no more
-//! characters will be drawn.  Therefore, special care is not required to avoid
-//! supplying a string that is "too long" to display.
+//! The column and row address commands also move the address pointer to the
+//! start of the window, so each is only needed if its range differs from the
+//! current one or the pointer is not already at the start of it.  The re-map
+//! command is only needed if the increment mode differs.  The shadow state is
+//! updated as if the commands had been sent.
 //!
-//! This function is contained in <tt>osram128x64x4.c</tt>, with
-//! <tt>osram128x64x4.h</tt> containing the API definition for use by
-//! applications.
+//! \return Returns the number of command bytes placed in \e pucBuffer, which
+//! may be zero.
+//
+//*****************************************************************************
+static unsigned long
+OSRAMWindowCommands(unsigned long ulX0, unsigned long ulX1, unsigned long ulY0,
+                    unsigned long ulY1, unsigned char ucRemap,
+                    unsigned char *pucBuffer)
+{
+    tOSRAMAddressState *psState = &g_sOSRAMAddress;
+    unsigned long ulCount = 0;
+
+    if(!psState->bValid || (psState->ucColumnStart != ulX0) ||
+       (psState->ucColumnEnd != ulX1) || (psState->ucColumn != ulX0))
+    {
+        pucBuffer[ulCount++] = 0x15;
+        pucBuffer[ulCount++] = ulX0;
+        pucBuffer[ulCount++] = ulX1;
+    }
+    if(!psState->bValid || (psState->ucRowStart != ulY0) ||
+       (psState->ucRowEnd != ulY1) || (psState->ucRow != ulY0))
+    {
+        pucBuffer[ulCount++] = 0x75;
+        pucBuffer[ulCount++] = ulY0;
+        pucBuffer[ulCount++] = ulY1;
+    }
+    if(!psState->bValid || (psState->ucRemap != ucRemap))
+    {
+        pucBuffer[ulCount++] = 0xA0;
+        pucBuffer[ulCount++] = ucRemap;
+    }
+
+    psState->ucColumnStart = ulX0;
+    psState->ucColumnEnd = ulX1;
+    psState->ucColumn = ulX0;
+    psState->ucRowStart = ulY0;
+    psState->ucRowEnd = ulY1;
+    psState->ucRow = ulY0;
+    psState->ucRemap = ucRemap;
+    psState->bValid = true;
+
+    return(ulCount);
+}
+
+//*****************************************************************************
+//
+//! \internal
 //!
-//! \note Because the OLED display packs 2 pixels of data in a single byte, the
-//! parameter \e ulX must be an even column number (e.g. 0, 2, 4, etc).
+//! Opens a window in the display RAM, sending only the commands needed.
 //!
 //! \return None.
 //
 //*****************************************************************************
-void
-OSRAM128x64x4StringDraw(const char *pcStr, unsigned long ulX,
-                        unsigned long ulY, unsigned char ucLevel)
+static void
+OSRAMSetWindow(unsigned long ulX0, unsigned long ulX1, unsigned long ulY0,
+               unsigned long ulY1, unsigned char ucRemap)
 {
-    static unsigned char pucBuffer[8];
-    unsigned long ulIdx1, ulIdx2;
-    unsigned char ucTemp;
+    unsigned char pucBuffer[OSRAM_WINDOW_COST];
+    unsigned long ulCount;
 
     //
-    // Check the arguments.
+    // Nothing reaches the controller while the SSI port is disabled, so the
+    // shadow state must not change either.
     //
-    ASSERT(ulX < 128);
-    ASSERT((ulX & 1) == 0);
-    ASSERT(ulY < 64);
-    ASSERT(ucLevel < 16);
+    if(!g_bSSIEnabled)
+    {
+        return;
+    }
 
-    //
-    // Setup a window starting at the specified column and row, ending
-    // at the right edge of the display and 8 rows down (single character row).
-    //
-    pucBuffer[0] = 0x15;
-    pucBuffer[1] = ulX / 2;
-    pucBuffer[2] = 63;
-    OSRAMWriteCommand(pucBuffer, 3);
-    pucBuffer[0] = 0x75;
-    pucBuffer[1] = ulY;
-    pucBuffer[2] = ulY + 7;
-    OSRAMWriteCommand(pucBuffer, 3);
-    OSRAMWriteCommand(g_pucOSRAM128x64x4VerticalInc,
-                      sizeof(g_pucOSRAM128x64x4VerticalInc));
+    ulCount = OSRAMWindowCommands(ulX0, ulX1, ulY0, ulY1, ucRemap, pucBuffer);
+    if(ulCount != 0)
+    {
+        OSRAMWriteCommand(pucBuffer, ulCount);
+    }
+}
+
+#if OSRAM_USE_GLYPH_ATLAS || OSRAM_COMPARE_GLYPH_PATHS
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Returns a character from the pre-expanded glyph table.
+//!
+//! \param ulIndex is the index of the character in the font.
+//! \param ucLevel is the 4-bit grey scale value of the lit pixels.
+//! \param pucBuffer is a 24 byte buffer that may be used to build the result.
+//!
+//! \return Returns a pointer to the 24 bytes of the character.
+//
+//*****************************************************************************
+static const unsigned char *
+OSRAMGlyphAtlasGet(unsigned long ulIndex, unsigned char ucLevel,
+                   unsigned char *pucBuffer)
+{
+    unsigned char ucMask;
+    unsigned long ulIdx;
 
     //
-    // Loop while there are more characters in the string.
+    // Full brightness text can be sent straight out of the table; any other
+    // level just needs each byte masked.
     //
-    while(*pcStr != 0)
+    if(ucLevel == 15)
     {
-        //
-        // Get a working copy of the current character and convert to an
-        // index into the character bit-map array.
-        //
-        ucTemp = *pcStr;
-        ucTemp &= 0x7F;
-        if(ucTemp < ' ')
-        {
-            ucTemp = ' ';
-        }
-        else
-        {
-            ucTemp -= ' ';
-        }
+        return(g_pucOSRAMGlyphs[ulIndex]);
+    }
+    ucMask = (ucLevel << 4) | ucLevel;
+    for(ulIdx = 0; ulIdx < 24; ulIdx++)
+    {
+        pucBuffer[ulIdx] = g_pucOSRAMGlyphs[ulIndex][ulIdx] & ucMask;
+    }
+
+    return(pucBuffer);
+}
+#endif
+
+#if !OSRAM_USE_GLYPH_ATLAS || OSRAM_COMPARE_GLYPH_PATHS
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Expands a character of the 1-bit font.
+//!
+//! \param ulIndex is the index of the character in the font.
+//! \param ucLevel is the 4-bit grey scale value of the lit pixels.
+//! \param pucBuffer is a 24 byte buffer in which the result is built.
+//!
+//! \return Returns \e pucBuffer.
+//
+//*****************************************************************************
+static const unsigned char *
+OSRAMGlyphExpand(unsigned long ulIndex, unsigned char ucLevel,
+                 unsigned char *pucBuffer)
+{
+    unsigned long ulIdx1, ulIdx2;
 
+    for(ulIdx1 = 0; ulIdx1 < 3; ulIdx1++)
+    {
         //
-        // Build and display the character buffer.
+        // Convert two columns of 1-bit font data into a single data
+        // byte column of 4-bit font data.
         //
-        for(ulIdx1 = 0; ulIdx1 < 3; ulIdx1++)
+        for(ulIdx2 = 0; ulIdx2 < 8; ulIdx2++)
         {
-            //
-            // Convert two columns of 1-bit font data into a single data
-            // byte column of 4-bit font data.
-            //
-            for(ulIdx2 = 0; ulIdx2 < 8; ulIdx2++)
-            {
-                pucBuffer[ulIdx2] = 0;
-                if(g_pucFont[ucTemp][ulIdx1*2] & (1 << ulIdx2))
-                {
-                    pucBuffer[ulIdx2] = ((ucLevel << 4) & 0xf0);
-                }
-                if((ulIdx1 < 2) &&
-                    (g_pucFont[ucTemp][ulIdx1*2+1] & (1 << ulIdx2)))
-                {
-                    pucBuffer[ulIdx2] |= ((ucLevel << 0) & 0x0f);
-                }
-            }
-
-            //
-            // If there is room, dump the single data byte column to the
-            // display.  Otherwise, bail out.
-            //
-            if(ulX < 126)
+            pucBuffer[(ulIdx1 * 8) + ulIdx2] = 0;
+            if(g_pucFont[ulIndex][ulIdx1*2] & (1 << ulIdx2))
             {
-                OSRAMWriteData(pucBuffer, 8);
-                ulX += 2;
+                pucBuffer[(ulIdx1 * 8) + ulIdx2] = ((ucLevel << 4) & 0xf0);
             }
-            else
+            if((ulIdx1 < 2) &&
+                (g_pucFont[ulIndex][ulIdx1*2+1] & (1 << ulIdx2)))
             {
-                return;
+                pucBuffer[(ulIdx1 * 8) + ulIdx2] |= ((ucLevel << 0) & 0x0f);
             }
         }
-
-        //
-        // Advance to the next character.
-        //
-        pcStr++;
     }
+
+    return(pucBuffer);
 }
+#endif
 
 //*****************************************************************************
 //
-//! Displays an image on the OLED display.
+//! \internal
 //!
-//! \param pucImage is a pointer to the image data.
-//! \param ulX is the horizontal position to display this image, specified in
-//! columns from the left edge of the display.
-//! \param ulY is the vertical position to display this image, specified in
-//! rows from the top of the display.
-//! \param ulWidth is the width of the image, specified in columns.
-//! \param ulHeight is the height of the image, specified in rows.
+//! Returns a character of the font in the native format of the display RAM.
 //!
-//! This function will display a bitmap graphic on the display.  Because of the
-//! format of the display RAM, the starting column (/e ulX) and the number of
-//! columns (/e ulWidth) must be an integer multiple of two.
+//! \param cChar is the character.
+//! \param ucLevel is the 4-bit grey scale value of the lit pixels.
+//! \param pucBuffer is a 24 byte buffer that may be used to build the result.
 //!
-//! The image data is organized with the first row of image data appearing left
+//! The character is returned as three byte columns of eight rows, in the order
+//! they are sent in vertical address increment mode.  Only the ASCII
+//! characters between 32 (space) and 126 (tilde) are supported.
+//!
+//! \return Returns a pointer to the 24 bytes of the character, which is
+//! either \e pucBuffer or a pointer into the glyph table.
+//
+//*****************************************************************************
+static const unsigned char *
+OSRAMGlyphGet(char cChar, unsigned char ucLevel, unsigned char *pucBuffer)
+{
+    unsigned char ucTemp;
+
+    //
+    // Convert the character to an index into the character bit-map array.
+    //
+    ucTemp = cChar;
+    ucTemp &= 0x7F;
+    if(ucTemp < ' ')
+    {
+        ucTemp = ' ';
+    }
+    else
+    {
+        ucTemp -= ' ';
+    }
+
+#if OSRAM_COMPARE_GLYPH_PATHS
+    if(!g_bOSRAMUseGlyphAtlas)
+    {
+        return(OSRAMGlyphExpand(ucTemp, ucLevel, pucBuffer));
+    }
+    return(OSRAMGlyphAtlasGet(ucTemp, ucLevel, pucBuffer));
+#elif OSRAM_USE_GLYPH_ATLAS
+    return(OSRAMGlyphAtlasGet(ucTemp, ucLevel, pucBuffer));
+#else
+    return(OSRAMGlyphExpand(ucTemp, ucLevel, pucBuffer));
+#endif
+}
+
+#if OSRAM_COMPARE_GLYPH_PATHS
+//*****************************************************************************
+//
+//! Selects how the string drawing functions build each character.
+//!
+//! \param bEnable is \b true to copy characters from the pre-expanded glyph
+//! table, or \b false to expand the 1-bit font for every character.
+//!
+//! Only built with OSRAM_COMPARE_GLYPH_PATHS, so that the benchmarks can time
+//! both paths in one run.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4GlyphAtlasEnable(tBoolean bEnable)
+{
+    g_bOSRAMUseGlyphAtlas = bEnable;
+}
+#endif
+
+//*****************************************************************************
+//
+//! Clears the OLED display.
+//!
+//! This function will clear the display RAM.  All pixels in the display will
+//! be turned off.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4Clear(void)
+{
+    unsigned long ulRow, ulColumn;
+
+    //
+    // The display RAM is about to be blank, so the frame buffer is too and
+    // there is nothing left to flush.
+    //
+    for(ulRow = 0; ulRow < OSRAM_FRAME_ROWS; ulRow++)
+    {
+        for(ulColumn = 0; ulColumn < OSRAM_FRAME_COLUMNS; ulColumn++)
+        {
+            g_pucOSRAMFrame[ulRow][ulColumn] = 0;
+        }
+    }
+    g_ulOSRAMDirtyCount = 0;
+
+    //
+    // Set the window to fill the entire display.
+    //
+    OSRAMSetWindow(0, 63, 0, 79, g_pucOSRAM128x64x4VerticalInc[1]);
+
+    //
+    // Fill every column of every row with 0 in a single burst.
+    //
+    OSRAMWriteDataFill(0, (128 / 2) * 80);
+}
+
+//*****************************************************************************
+//
+//! Displays a string on the OLED display.
+//!
+//! \param pcStr is a pointer to the string to display.
+//! \param ulX is the horizontal position to display the string, specified in
+//! columns from the left edge of the display.
+//! \param ulY is the vertical position to display the string, specified in
+//! rows from the top edge of the display.
+//! \param ucLevel is the 4-bit grey scale value to be used for displayed text.
+//!
+//! This function will draw a string on the display.  Only the ASCII characters
+//! between 32 (space) and 126 (tilde) are supported; other characters will
+//! result in random data being draw on the display (based on whatever appears
+//! before/after the font in memory).  The font is mono-spaced, so characters
+//! such as "i" and "l" have more white space around them than characters such
+//! as "m" or "w".
+//!
+//! If the drawing of the string reaches the right edge of the display, no more
+//! characters will be drawn.  Therefore, special care is not required to avoid
+//! supplying a string that is "too long" to display.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \note Because the OLED display packs 2 pixels of data in a single byte, the
+//! parameter \e ulX must be an even column number (e.g. 0, 2, 4, etc).
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4StringDraw(const char *pcStr, unsigned long ulX,
+                        unsigned long ulY, unsigned char ucLevel)
+{
+    static unsigned char pucBuffer[24];
+    const unsigned char *pucGlyph;
+    unsigned long ulColumns;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulX < 128);
+    ASSERT((ulX & 1) == 0);
+    ASSERT(ulY < 64);
+    ASSERT(ucLevel < 16);
+
+    //
+    // Setup a window starting at the specified column and row, ending
+    // at the right edge of the display and 8 rows down (single character row).
+    //
+    OSRAMSetWindow(ulX / 2, 63, ulY, ulY + 7,
+                   g_pucOSRAM128x64x4VerticalInc[1]);
+
+    //
+    // Loop while there are more characters in the string.
+    //
+    while(*pcStr != 0)
+    {
+        //
+        // Work out how many of the three byte columns of this character fit
+        // before the right edge of the display.  If none do, bail out.
+        //
+        ulColumns = (ulX < 126) ? ((126 - ulX) / 2) : 0;
+        if(ulColumns == 0)
+        {
+            return;
+        }
+        if(ulColumns > 3)
+        {
+            ulColumns = 3;
+        }
+
+        //
+        // Display the character as a single burst.
+        //
+        pucGlyph = OSRAMGlyphGet(*pcStr, ucLevel, pucBuffer);
+        OSRAMWriteData(pucGlyph, ulColumns * 8);
+        ulX += ulColumns * 2;
+
+        //
+        // Advance to the next character.
+        //
+        pcStr++;
+    }
+}
+
+//*****************************************************************************
+//
+//! Displays an image on the OLED display.
+//!
+//! \param pucImage is a pointer to the image data.
+//! \param ulX is the horizontal position to display this image, specified in
+//! columns from the left edge of the display.
+//! \param ulY is the vertical position to display this image, specified in
+//! rows from the top of the display.
+//! \param ulWidth is the width of the image, specified in columns.
+//! \param ulHeight is the height of the image, specified in rows.
+//!
+//! This function will display a bitmap graphic on the display.  Because of the
+//! format of the display RAM, the starting column (/e ulX) and the number of
+//! columns (/e ulWidth) must be an integer multiple of two.
+//!
+//! The image data is organized with the first row of image data appearing left
 //! to right, followed immediately by the second row of image data.  Each byte
 //! contains the data for two columns in the current row, with the leftmost
 //! column being contained in bits 7:4 and the rightmost column being contained
@@ -643,8 +1134,6 @@ OSRAM128x64x4ImageDraw(const unsigned char *pucImage, unsigned long ulX,
                unsigned long ulY, unsigned long ulWidth,
                unsigned long ulHeight)
 {
-    static unsigned char pucBuffer[8];
-
     //
     // Check the arguments.
     //
@@ -659,32 +1148,15 @@ OSRAM128x64x4ImageDraw(const unsigned char *pucImage, unsigned long ulX,
     // Setup a window starting at the specified column and row, and ending
     // at the column + width and row+height.
     //
-    pucBuffer[0] = 0x15;
-    pucBuffer[1] = ulX / 2;
-    pucBuffer[2] = (ulX + ulWidth - 2) / 2;
-    OSRAMWriteCommand(pucBuffer, 3);
-    pucBuffer[0] = 0x75;
-    pucBuffer[1] = ulY;
-    pucBuffer[2] = ulY + ulHeight - 1;
-    OSRAMWriteCommand(pucBuffer, 3);
-    OSRAMWriteCommand(g_pucOSRAM128x64x4HorizontalInc,
-                      sizeof(g_pucOSRAM128x64x4HorizontalInc));
+    OSRAMSetWindow(ulX / 2, (ulX + ulWidth - 2) / 2, ulY, ulY + ulHeight - 1,
+                   g_pucOSRAM128x64x4HorizontalInc[1]);
 
     //
-    // Loop while there are more rows to display.
+    // The rows of the image are contiguous and the window wraps from the end
+    // of one row to the start of the next, so the whole image can be sent in
+    // one burst.
     //
-    while(ulHeight--)
-    {
-        //
-        // Write this row of image data.
-        //
-        OSRAMWriteData(pucImage, (ulWidth / 2));
-
-        //
-        // Advance to the next row of the image.
-        //
-        pucImage += (ulWidth / 2);
-    }
+    OSRAMWriteData(pucImage, (ulWidth / 2) * ulHeight);
 }
 
 //*****************************************************************************
@@ -736,6 +1208,17 @@ OSRAM128x64x4Enable(unsigned long ulFrequency)
     {
     }
 
+#if OSRAM_USE_INTERRUPTS
+    //
+    // Let the SSI0 interrupt drive frame buffer flushes.  It calls into the
+    // kernel, so it must not be above the maximum system call priority.  The
+    // individual interrupt sources are only enabled while a flush runs.
+    //
+    SSIIntDisable(SSI0_BASE, SSI_TXFF | SSI_RXFF | SSI_RXTO | SSI_RXOR);
+    IntPrioritySet(INT_SSI0, configKERNEL_INTERRUPT_PRIORITY);
+    IntEnable(INT_SSI0);
+#endif
+
     //
     // Indicate that the OSRAM driver can use the SSI Port.
     //
@@ -767,6 +1250,10 @@ OSRAM128x64x4Disable(void)
     //
     g_bSSIEnabled = false;
 
+#if OSRAM_USE_INTERRUPTS
+    IntDisable(INT_SSI0);
+#endif
+
     //
     // Drain the receive fifo.
     //
@@ -859,6 +1346,11 @@ OSRAM128x64x4Init(unsigned long ulFrequency)
         OSRAMWriteCommand(g_pucOSRAM128x64x4Init + ulIdx + 1,
                           g_pucOSRAM128x64x4Init[ulIdx] - 1);
     }
+
+    //
+    // The sequence reprograms the address windows and re-map setting.
+    //
+    g_sOSRAMAddress.bValid = false;
 }
 
 //*****************************************************************************
@@ -893,6 +1385,11 @@ OSRAM128x64x4DisplayOn(void)
         OSRAMWriteCommand(g_pucOSRAM128x64x4Init + ulIdx + 1,
                           g_pucOSRAM128x64x4Init[ulIdx] - 1);
     }
+
+    //
+    // The sequence reprograms the address windows and re-map setting.
+    //
+    g_sOSRAMAddress.bValid = false;
 }
 
 //*****************************************************************************
@@ -927,44 +1424,957 @@ OSRAM128x64x4DisplayOff(void)
 
 //*****************************************************************************
 //
-// Close the Doxygen group.
-//! @}
+//! \internal
+//!
+//! Returns the number of bytes covered by a frame buffer rectangle.
 //
 //*****************************************************************************
+static unsigned long
+OSRAMRectArea(const tOSRAMRect *psRect)
+{
+    return((psRect->ucX1 - psRect->ucX0 + 1) *
+           (psRect->ucY1 - psRect->ucY0 + 1));
+}
 
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Computes the bounding box of two frame buffer rectangles.
+//
+//*****************************************************************************
+static void
+OSRAMRectUnion(tOSRAMRect *psResult, const tOSRAMRect *psA,
+               const tOSRAMRect *psB)
+{
+    psResult->ucX0 = (psA->ucX0 < psB->ucX0) ? psA->ucX0 : psB->ucX0;
+    psResult->ucY0 = (psA->ucY0 < psB->ucY0) ? psA->ucY0 : psB->ucY0;
+    psResult->ucX1 = (psA->ucX1 > psB->ucX1) ? psA->ucX1 : psB->ucX1;
+    psResult->ucY1 = (psA->ucY1 > psB->ucY1) ? psA->ucY1 : psB->ucY1;
+}
 
-void DefaultBlockDraw(int x, int y, int w, int h)
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Marks a region of the frame buffer as needing to be sent to the display.
+//!
+//! \param ulX0 is the first byte column of the region.
+//! \param ulY0 is the first row of the region.
+//! \param ulX1 is the last byte column of the region.
+//! \param ulY1 is the last row of the region.
+//!
+//! The region is merged with any pending region for which a single window is
+//! cheaper than two.  If the dirty list is full, the region is merged with the
+//! pending region that grows the least.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAMDirtyAdd(unsigned long ulX0, unsigned long ulY0, unsigned long ulX1,
+              unsigned long ulY1)
 {
-    // 参数检查
-    if (x < 0 || x >= 128 || y < 0 || y >= 64) return;
-    if ((x & 1) != 0) x--;           // 保证 x 是偶数
-    if ((w & 1) != 0) w++;           // 保证宽度是偶数
-    if (x + w > 128) w = 128 - x;
-    if (y + h > 64)  h = 64 - y;
+    tOSRAMRect sRect, sUnion;
+    unsigned long ulIdx, ulBest, ulCost, ulBestCost;
 
-    unsigned char buffer[8];
-    unsigned char rowData[w / 2];
-    // 每个像素填充为 0xF -> 白色
-    for (int i = 0; i < w / 2; i++)
-        rowData[i] = 0xFF;
+    sRect.ucX0 = ulX0;
+    sRect.ucY0 = ulY0;
+    sRect.ucX1 = ulX1;
+    sRect.ucY1 = ulY1;
 
-    // 设置显示窗口
-    buffer[0] = 0x15;         // 列地址命令
-    buffer[1] = x / 2;
-    buffer[2] = (x + w - 2) / 2;
-    OSRAMWriteCommand(buffer, 3);
+    while(1)
+    {
+        //
+        // Look for a pending region that is worth merging with this one.  A
+        // merge can make the new bounding box worth merging with another
+        // region, so keep going until nothing changes.
+        //
+        for(ulIdx = 0; ulIdx < g_ulOSRAMDirtyCount; ulIdx++)
+        {
+            OSRAMRectUnion(&sUnion, &sRect, &g_psOSRAMDirty[ulIdx]);
+            if(OSRAMRectArea(&sUnion) <= (OSRAMRectArea(&sRect) +
+                                          OSRAMRectArea(&g_psOSRAMDirty[ulIdx]) +
+                                          OSRAM_WINDOW_COST))
+            {
+                break;
+            }
+        }
 
-    buffer[0] = 0x75;         // 行地址命令
-    buffer[1] = y;
-    buffer[2] = y + h - 1;
-    OSRAMWriteCommand(buffer, 3);
+        //
+        // If nothing was worth merging and there is a free slot, stop here.
+        //
+        if((ulIdx == g_ulOSRAMDirtyCount) &&
+           (g_ulOSRAMDirtyCount < OSRAM_DIRTY_RECTS))
+        {
+            break;
+        }
 
-    OSRAMWriteCommand(g_pucOSRAM128x64x4HorizontalInc,
-                      sizeof(g_pucOSRAM128x64x4HorizontalInc));
+        //
+        // Otherwise the list is full, so pick the merge that adds the fewest
+        // bytes to the flush.
+        //
+        if(ulIdx == g_ulOSRAMDirtyCount)
+        {
+            ulBest = 0;
+            ulBestCost = ~0UL;
+            for(ulIdx = 0; ulIdx < g_ulOSRAMDirtyCount; ulIdx++)
+            {
+                OSRAMRectUnion(&sUnion, &sRect, &g_psOSRAMDirty[ulIdx]);
+                ulCost = (OSRAMRectArea(&sUnion) -
+                          OSRAMRectArea(&g_psOSRAMDirty[ulIdx]));
+                if(ulCost < ulBestCost)
+                {
+                    ulBest = ulIdx;
+                    ulBestCost = ulCost;
+                }
+            }
+            ulIdx = ulBest;
+        }
 
-    // 循环写行数据
-    while (h--)
-    {
-        OSRAMWriteData(rowData, w / 2);
+        //
+        // Absorb the chosen region and remove it from the list.
+        //
+        OSRAMRectUnion(&sRect, &sRect, &g_psOSRAMDirty[ulIdx]);
+        g_psOSRAMDirty[ulIdx] = g_psOSRAMDirty[--g_ulOSRAMDirtyCount];
     }
+
+    g_psOSRAMDirty[g_ulOSRAMDirtyCount++] = sRect;
+}
+
+//*****************************************************************************
+//
+//! Clears the off-screen frame buffer.
+//!
+//! This function turns off all pixels in the frame buffer.  Only the regions
+//! that were not already blank are marked as needing to be flushed, so
+//! clearing a mostly empty frame is cheap.  Nothing is sent to the display
+//! until OSRAM128x64x4Flush() is called.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4FrameClear(void)
+{
+    unsigned long ulRow, ulFirst, ulLast, ulIdx;
+
+    for(ulRow = 0; ulRow < OSRAM_FRAME_ROWS; ulRow++)
+    {
+        //
+        // Find the span of this row that has any pixels turned on.
+        //
+        for(ulFirst = 0; ulFirst < OSRAM_FRAME_COLUMNS; ulFirst++)
+        {
+            if(g_pucOSRAMFrame[ulRow][ulFirst] != 0)
+            {
+                break;
+            }
+        }
+        if(ulFirst == OSRAM_FRAME_COLUMNS)
+        {
+            continue;
+        }
+        for(ulLast = OSRAM_FRAME_COLUMNS - 1; ulLast > ulFirst; ulLast--)
+        {
+            if(g_pucOSRAMFrame[ulRow][ulLast] != 0)
+            {
+                break;
+            }
+        }
+
+        //
+        // Blank the span and remember to send it.
+        //
+        for(ulIdx = ulFirst; ulIdx <= ulLast; ulIdx++)
+        {
+            g_pucOSRAMFrame[ulRow][ulIdx] = 0;
+        }
+        OSRAMDirtyAdd(ulFirst, ulRow, ulLast, ulRow);
+    }
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle in the off-screen frame buffer.
+//!
+//! \param ulX is the left edge of the rectangle, specified in columns.
+//! \param ulY is the top edge of the rectangle, specified in rows.
+//! \param ulWidth is the width of the rectangle, specified in columns.
+//! \param ulHeight is the height of the rectangle, specified in rows.
+//! \param ucLevel is the 4-bit grey scale value used to fill the rectangle.
+//!
+//! This function sets every pixel of the rectangle to \e ucLevel.  Unlike
+//! the functions that draw straight to the display, the rectangle may start
+//! and end on odd columns.  Portions of the rectangle outside of the display
+//! are clipped.  The rectangle is only marked as needing to be flushed if
+//! this actually changed the frame buffer.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4FrameRectFill(unsigned long ulX, unsigned long ulY,
+                           unsigned long ulWidth, unsigned long ulHeight,
+                           unsigned char ucLevel)
+{
+    unsigned long ulRow, ulCol, ulX1, ulY1;
+    unsigned char ucMask, ucFill, ucNew;
+    tBoolean bChanged;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ucLevel < 16);
+
+    //
+    // Clip the rectangle to the display.
+    //
+    if((ulX >= 128) || (ulY >= 64) || (ulWidth == 0) || (ulHeight == 0))
+    {
+        return;
+    }
+    ulX1 = ((ulWidth > (128 - ulX)) ? 128 : (ulX + ulWidth)) - 1;
+    ulY1 = ((ulHeight > (64 - ulY)) ? 64 : (ulY + ulHeight)) - 1;
+
+    ucFill = (ucLevel << 4) | ucLevel;
+    bChanged = false;
+
+    for(ulRow = ulY; ulRow <= ulY1; ulRow++)
+    {
+        for(ulCol = ulX / 2; ulCol <= ulX1 / 2; ulCol++)
+        {
+            //
+            // Work out which nibbles of this byte are inside the rectangle.
+            //
+            ucMask = 0xff;
+            if((ulCol == ulX / 2) && (ulX & 1))
+            {
+                ucMask &= 0x0f;
+            }
+            if((ulCol == ulX1 / 2) && !(ulX1 & 1))
+            {
+                ucMask &= 0xf0;
+            }
+
+            ucNew = ((g_pucOSRAMFrame[ulRow][ulCol] & ~ucMask) |
+                     (ucFill & ucMask));
+            if(ucNew != g_pucOSRAMFrame[ulRow][ulCol])
+            {
+                g_pucOSRAMFrame[ulRow][ulCol] = ucNew;
+                bChanged = true;
+            }
+        }
+    }
+
+    if(bChanged)
+    {
+        OSRAMDirtyAdd(ulX / 2, ulY, ulX1 / 2, ulY1);
+    }
+}
+
+//*****************************************************************************
+//
+//! Displays a string in the off-screen frame buffer.
+//!
+//! \param pcStr is a pointer to the string to display.
+//! \param ulX is the horizontal position to display the string, specified in
+//! columns from the left edge of the display.
+//! \param ulY is the vertical position to display the string, specified in
+//! rows from the top edge of the display.
+//! \param ucLevel is the 4-bit grey scale value to be used for displayed text.
+//!
+//! This function behaves like OSRAM128x64x4StringDraw(), including the
+//! clipping at the right edge of the display and the requirement that \e ulX
+//! is even, but draws into the frame buffer.  Rows that fall below the bottom
+//! of the display are clipped.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4FrameStringDraw(const char *pcStr, unsigned long ulX,
+                             unsigned long ulY, unsigned char ucLevel)
+{
+    unsigned char pucBuffer[24];
+    const unsigned char *pucGlyph;
+    unsigned long ulIdx1, ulIdx2, ulStart, ulRows, ulColumns;
+    unsigned char ucByte;
+    tBoolean bChanged;
+
+    //
+    // Check the arguments.
+    //
+    ASSERT(ulX < 128);
+    ASSERT((ulX & 1) == 0);
+    ASSERT(ulY < 64);
+    ASSERT(ucLevel < 16);
+
+    ulStart = ulX;
+    ulRows = ((ulY + 8) > 64) ? (64 - ulY) : 8;
+    bChanged = false;
+
+    //
+    // Loop while there are more characters in the string.
+    //
+    while(*pcStr != 0)
+    {
+        //
+        // Work out how many of the three byte columns of this character fit
+        // before the right edge of the display.
+        //
+        ulColumns = (ulX < 126) ? ((126 - ulX) / 2) : 0;
+        if(ulColumns == 0)
+        {
+            break;
+        }
+        if(ulColumns > 3)
+        {
+            ulColumns = 3;
+        }
+
+        //
+        // Copy the character into the frame buffer a column at a time.
+        //
+        pucGlyph = OSRAMGlyphGet(*pcStr, ucLevel, pucBuffer);
+        for(ulIdx1 = 0; ulIdx1 < ulColumns; ulIdx1++)
+        {
+            for(ulIdx2 = 0; ulIdx2 < ulRows; ulIdx2++)
+            {
+                ucByte = pucGlyph[(ulIdx1 * 8) + ulIdx2];
+                if(g_pucOSRAMFrame[ulY + ulIdx2][ulX / 2] != ucByte)
+                {
+                    g_pucOSRAMFrame[ulY + ulIdx2][ulX / 2] = ucByte;
+                    bChanged = true;
+                }
+            }
+            ulX += 2;
+        }
+
+        //
+        // Advance to the next character.
+        //
+        pcStr++;
+    }
+
+    if(bChanged)
+    {
+        OSRAMDirtyAdd(ulStart / 2, ulY, (ulX / 2) - 1, ulY + ulRows - 1);
+    }
+}
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Converts the pending dirty regions into a list of transfer segments.
+//!
+//! Each region becomes a command segment that opens a window over it,
+//! followed by a data segment that reads the region straight out of the frame
+//! buffer.  The dirty list is emptied.
+//!
+//! \return Returns the number of segments in the list.
+//
+//*****************************************************************************
+static unsigned long
+OSRAMFlushPrepare(void)
+{
+    unsigned long ulIdx, ulCount, ulCommand;
+    const tOSRAMRect *psRect;
+    unsigned char *pucCommand;
+
+    ulCount = 0;
+    for(ulIdx = 0; ulIdx < g_ulOSRAMDirtyCount; ulIdx++)
+    {
+        psRect = &g_psOSRAMDirty[ulIdx];
+
+        //
+        // Setup a window covering the region.  A data segment covers its
+        // whole window, which leaves the address pointer back at the start of
+        // the window, so the shadow state needs no further update.
+        //
+        pucCommand = g_pucOSRAMFlushCommand[ulIdx];
+        ulCommand = OSRAMWindowCommands(psRect->ucX0, psRect->ucX1,
+                                        psRect->ucY0, psRect->ucY1,
+                                        g_pucOSRAM128x64x4HorizontalInc[1],
+                                        pucCommand);
+        if(ulCommand != 0)
+        {
+            g_psOSRAMSegment[ulCount].pucData = pucCommand;
+            g_psOSRAMSegment[ulCount].ucWidth = ulCommand;
+            g_psOSRAMSegment[ulCount].ucRows = 1;
+            g_psOSRAMSegment[ulCount].ucStride = ulCommand;
+            g_psOSRAMSegment[ulCount].bData = false;
+            ulCount++;
+        }
+
+        //
+        // Send the region a row at a time.
+        //
+        g_psOSRAMSegment[ulCount].pucData =
+            &g_pucOSRAMFrame[psRect->ucY0][psRect->ucX0];
+        g_psOSRAMSegment[ulCount].ucWidth = psRect->ucX1 - psRect->ucX0 + 1;
+        g_psOSRAMSegment[ulCount].ucRows = psRect->ucY1 - psRect->ucY0 + 1;
+        g_psOSRAMSegment[ulCount].ucStride = OSRAM_FRAME_COLUMNS;
+        g_psOSRAMSegment[ulCount].bData = true;
+        ulCount++;
+    }
+
+    g_ulOSRAMDirtyCount = 0;
+
+    return(ulCount);
+}
+
+#if OSRAM_USE_INTERRUPTS
+//*****************************************************************************
+//
+//! Handles the SSI0 interrupt while a frame buffer flush is in progress.
+//!
+//! The transmit FIFO interrupt fires whenever the FIFO is half empty or less.
+//! This handler discards everything that has been clocked back into the
+//! receive FIFO, then tops the transmit FIFO up from the current segment.
+//! The D/C signal is sampled by the controller with every byte, so before
+//! switching between command and data segments the handler waits for the
+//! bytes already in the FIFO (at most eight) to be shifted out.
+//!
+//! Once the last byte has been sent, the transmit interrupt is disabled and
+//! the task that started the flush is notified.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4IntHandler(void)
+{
+    const tOSRAMSegment *psSegment;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    unsigned long ulTemp;
+
+    //
+    // Throw away the bytes clocked in while sending.
+    //
+    while(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_RNE)
+    {
+        ulTemp = HWREG(SSI0_BASE + SSI_O_DR);
+    }
+
+    while(g_ulOSRAMSegmentIdx < g_ulOSRAMSegmentCount)
+    {
+        psSegment = &g_psOSRAMSegment[g_ulOSRAMSegmentIdx];
+
+        //
+        // Switch the D/C signal once the previous segment has gone out.
+        //
+        if(psSegment->bData != g_bOSRAMDataMode)
+        {
+            while(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_BSY)
+            {
+            }
+            OSRAMSetDataMode(psSegment->bData);
+        }
+
+        //
+        // Fill the transmit FIFO from this segment.
+        //
+        while((g_ulOSRAMRow < psSegment->ucRows) &&
+              (HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_TNF))
+        {
+            HWREG(SSI0_BASE + SSI_O_DR) =
+                psSegment->pucData[(g_ulOSRAMRow * psSegment->ucStride) +
+                                   g_ulOSRAMColumn];
+            if(++g_ulOSRAMColumn == psSegment->ucWidth)
+            {
+                g_ulOSRAMColumn = 0;
+                g_ulOSRAMRow++;
+            }
+        }
+
+        //
+        // If the FIFO filled up first, wait for the next interrupt.
+        //
+        if(g_ulOSRAMRow < psSegment->ucRows)
+        {
+            return;
+        }
+
+        g_ulOSRAMRow = 0;
+        g_ulOSRAMSegmentIdx++;
+    }
+
+    //
+    // Everything has been queued.  Stop the transmit interrupt and wait for
+    // the tail of the transfer so the next user of the bus starts idle.
+    //
+    SSIIntDisable(SSI0_BASE, SSI_TXFF);
+    while(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_BSY)
+    {
+    }
+    while(HWREG(SSI0_BASE + SSI_O_SR) & SSI_SR_RNE)
+    {
+        ulTemp = HWREG(SSI0_BASE + SSI_O_DR);
+    }
+    (void)ulTemp;
+
+    g_ulOSRAMSegmentCount = 0;
+    vTaskNotifyGiveFromISR(g_xOSRAMFlushTask, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
+
+//*****************************************************************************
+//
+//! Sends the modified regions of the frame buffer to the display.
+//!
+//! This function opens one display window per pending dirty region and sends
+//! the frame buffer bytes of that region, so only the parts of the frame that
+//! changed since the previous flush are transferred.
+//!
+//! Once the scheduler is running, the transfer is driven by the SSI0
+//! interrupt and the calling task blocks until it completes, leaving the CPU
+//! to other tasks.  Before that, the transfer is polled.  Only one flush can be
+//! in progress at a time; a task that calls this function while another
+//! task's flush is in progress waits for it to complete first.
+//!
+//! This function is contained in <tt>osram128x64x4.c</tt>, with
+//! <tt>osram128x64x4.h</tt> containing the API definition for use by
+//! applications.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void
+OSRAM128x64x4Flush(void)
+{
+    unsigned long ulCount, ulIdx, ulRow;
+    const tOSRAMSegment *psSegment;
+
+#if OSRAM_USE_INTERRUPTS
+    if(xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+    {
+        //
+        // Claim the transfer engine, waiting for another task's flush to
+        // finish if necessary.
+        //
+        while(1)
+        {
+            taskENTER_CRITICAL();
+            if(!g_bOSRAMFlushBusy)
+            {
+                g_bOSRAMFlushBusy = true;
+                taskEXIT_CRITICAL();
+                break;
+            }
+            taskEXIT_CRITICAL();
+            vTaskDelay(1);
+        }
+
+        ulCount = OSRAMFlushPrepare();
+        if((ulCount != 0) && g_bSSIEnabled)
+        {
+            //
+            // The polled writes leave the bus idle, so the D/C signal can be
+            // set for the first segment straight away.
+            //
+            OSRAMSetDataMode(g_psOSRAMSegment[0].bData);
+
+            //
+            // The transmit FIFO is empty, so enabling its interrupt starts
+            // the transfer.
+            //
+            g_xOSRAMFlushTask = xTaskGetCurrentTaskHandle();
+            g_ulOSRAMSegmentIdx = 0;
+            g_ulOSRAMRow = 0;
+            g_ulOSRAMColumn = 0;
+            g_ulOSRAMSegmentCount = ulCount;
+            SSIIntEnable(SSI0_BASE, SSI_TXFF);
+
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        g_bOSRAMFlushBusy = false;
+        return;
+    }
+#endif
+
+    ulCount = OSRAMFlushPrepare();
+    for(ulIdx = 0; ulIdx < ulCount; ulIdx++)
+    {
+        psSegment = &g_psOSRAMSegment[ulIdx];
+        for(ulRow = 0; ulRow < psSegment->ucRows; ulRow++)
+        {
+            if(psSegment->bData)
+            {
+                OSRAMWriteData(psSegment->pucData +
+                               (ulRow * psSegment->ucStride),
+                               psSegment->ucWidth);
+            }
+            else
+            {
+                OSRAMWriteCommand(psSegment->pucData +
+                                  (ulRow * psSegment->ucStride),
+                                  psSegment->ucWidth);
+            }
+        }
+    }
+}
+
+//*****************************************************************************
+//
+// Translates a 24-bit RGB color to the 4-bit grey scale level used by the
+// display.  The weights approximate the luminance of each component.
+//
+//*****************************************************************************
+#define DPYCOLORTRANSLATE(c)    ((((((c) >> 16) & 0xff) * 77) +               \
+                                  ((((c) >> 8) & 0xff) * 150) +               \
+                                  (((c) & 0xff) * 29)) >> 12)
+
+//*****************************************************************************
+//
+//! \internal
+//!
+//! Sets a single pixel of the frame buffer.
+//!
+//! \param ulX is the X coordinate of the pixel.
+//! \param ulY is the Y coordinate of the pixel.
+//! \param ucLevel is the 4-bit grey scale value of the pixel.
+//!
+//! The caller is responsible for clipping and for marking the pixel dirty.
+//!
+//! \return Returns \b true if the frame buffer changed.
+//
+//*****************************************************************************
+static tBoolean
+OSRAMFramePixelSet(unsigned long ulX, unsigned long ulY, unsigned char ucLevel)
+{
+    unsigned char *pucByte, ucNew;
+
+    pucByte = &g_pucOSRAMFrame[ulY][ulX / 2];
+    if(ulX & 1)
+    {
+        ucNew = (*pucByte & 0xf0) | ucLevel;
+    }
+    else
+    {
+        ucNew = (*pucByte & 0x0f) | (ucLevel << 4);
+    }
+
+    if(ucNew == *pucByte)
+    {
+        return(false);
+    }
+    *pucByte = ucNew;
+    return(true);
+}
+
+//*****************************************************************************
+//
+//! Draws a pixel on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the pixel.
+//! \param lY is the Y coordinate of the pixel.
+//! \param ulValue is the color of the pixel.
+//!
+//! This function sets the given pixel in the frame buffer to a particular
+//! color.  The coordinates of the pixel are assumed to be within the extents
+//! of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAM128x64x4PixelDraw(void *pvDisplayData, long lX, long lY,
+                       unsigned long ulValue)
+{
+    if(OSRAMFramePixelSet(lX, lY, ulValue))
+    {
+        OSRAMDirtyAdd(lX / 2, lY, lX / 2, lY);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal sequence of pixels on the screen.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the first pixel.
+//! \param lY is the Y coordinate of the first pixel.
+//! \param lX0 is sub-pixel offset within the pixel data, which is valid for 1
+//! or 4 bit per pixel formats.
+//! \param lCount is the number of pixels to draw.
+//! \param lBPP is the number of bits per pixel; must be 1, 4, or 8.
+//! \param pucData is a pointer to the pixel data.  For 1 and 4 bit per pixel
+//! formats, the most significant bit(s) represent the left-most pixel.
+//! \param pucPalette is a pointer to the palette used to draw the pixels.
+//!
+//! This function draws a horizontal sequence of pixels into the frame buffer,
+//! using the supplied palette.  For 1 bit per pixel format, the palette
+//! contains pre-translated colors; for 4 and 8 bit per pixel formats, the
+//! palette contains 24-bit RGB values that must be translated before being
+//! written.  The whole sequence is marked dirty as a single region.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAM128x64x4PixelDrawMultiple(void *pvDisplayData, long lX, long lY,
+                               long lX0, long lCount, long lBPP,
+                               const unsigned char *pucData,
+                               const unsigned char *pucPalette)
+{
+    unsigned long ulIndex, ulColor;
+    long lStart;
+    tBoolean bChanged;
+
+    lStart = lX;
+    bChanged = false;
+
+    while(lCount > 0)
+    {
+        //
+        // Get the palette index of the next pixel.
+        //
+        switch(lBPP)
+        {
+            case 1:
+            {
+                ulIndex = (*pucData >> (7 - lX0)) & 1;
+                if(++lX0 == 8)
+                {
+                    lX0 = 0;
+                    pucData++;
+                }
+                break;
+            }
+
+            case 4:
+            {
+                ulIndex = (*pucData >> ((lX0 & 1) ? 0 : 4)) & 15;
+                if(++lX0 == 2)
+                {
+                    lX0 = 0;
+                    pucData++;
+                }
+                break;
+            }
+
+            case 8:
+            default:
+            {
+                ulIndex = *pucData++;
+                break;
+            }
+        }
+
+        //
+        // Look up the color.  The 1 bit per pixel palette is already
+        // translated; the others hold packed 24-bit RGB values.
+        //
+        if(lBPP == 1)
+        {
+            ulColor = ((const unsigned long *)pucPalette)[ulIndex];
+        }
+        else
+        {
+            ulIndex *= 3;
+            ulColor = ((pucPalette[ulIndex + 2] << 16) |
+                       (pucPalette[ulIndex + 1] << 8) |
+                       pucPalette[ulIndex]);
+            ulColor = DPYCOLORTRANSLATE(ulColor);
+        }
+
+        if(OSRAMFramePixelSet(lX, lY, ulColor))
+        {
+            bChanged = true;
+        }
+        lX++;
+        lCount--;
+    }
+
+    if(bChanged)
+    {
+        OSRAMDirtyAdd(lStart / 2, lY, (lX - 1) / 2, lY);
+    }
+}
+
+//*****************************************************************************
+//
+//! Draws a horizontal line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX1 is the X coordinate of the start of the line.
+//! \param lX2 is the X coordinate of the end of the line.
+//! \param lY is the Y coordinate of the line.
+//! \param ulValue is the color of the line.
+//!
+//! This function draws a horizontal line into the frame buffer.  The
+//! coordinates of the line are assumed to be within the extents of the
+//! display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAM128x64x4LineDrawH(void *pvDisplayData, long lX1, long lX2, long lY,
+                       unsigned long ulValue)
+{
+    OSRAM128x64x4FrameRectFill(lX1, lY, lX2 - lX1 + 1, 1, ulValue);
+}
+
+//*****************************************************************************
+//
+//! Draws a vertical line.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param lX is the X coordinate of the line.
+//! \param lY1 is the Y coordinate of the start of the line.
+//! \param lY2 is the Y coordinate of the end of the line.
+//! \param ulValue is the color of the line.
+//!
+//! This function draws a vertical line into the frame buffer.  The
+//! coordinates of the line are assumed to be within the extents of the
+//! display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAM128x64x4LineDrawV(void *pvDisplayData, long lX, long lY1, long lY2,
+                       unsigned long ulValue)
+{
+    OSRAM128x64x4FrameRectFill(lX, lY1, 1, lY2 - lY1 + 1, ulValue);
+}
+
+//*****************************************************************************
+//
+//! Fills a rectangle.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param pRect is a pointer to the structure describing the rectangle.
+//! \param ulValue is the color of the rectangle.
+//!
+//! This function fills a rectangle in the frame buffer.  The rectangle
+//! includes both its minimum and maximum coordinates, which are assumed to be
+//! within the extents of the display.
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAM128x64x4RectFill(void *pvDisplayData, const tRectangle *pRect,
+                      unsigned long ulValue)
+{
+    OSRAM128x64x4FrameRectFill(pRect->sXMin, pRect->sYMin,
+                               pRect->sXMax - pRect->sXMin + 1,
+                               pRect->sYMax - pRect->sYMin + 1, ulValue);
+}
+
+//*****************************************************************************
+//
+//! Translates a 24-bit RGB color to a display driver-specific color.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//! \param ulValue is the 24-bit RGB color.  The least-significant byte is the
+//! blue channel, the next byte is the green channel, and the third byte is the
+//! red channel.
+//!
+//! This function translates a color to the 4-bit grey scale level used by the
+//! display.
+//!
+//! \return Returns the display-driver specific color.
+//
+//*****************************************************************************
+static unsigned long
+OSRAM128x64x4ColorTranslate(void *pvDisplayData, unsigned long ulValue)
+{
+    return(DPYCOLORTRANSLATE(ulValue));
+}
+
+//*****************************************************************************
+//
+//! Flushes any cached drawing operations.
+//!
+//! \param pvDisplayData is a pointer to the driver-specific data for this
+//! display driver.
+//!
+//! This function sends the regions of the frame buffer changed by the drawing
+//! operations to the display; see OSRAM128x64x4Flush().
+//!
+//! \return None.
+//
+//*****************************************************************************
+static void
+OSRAM128x64x4DisplayFlush(void *pvDisplayData)
+{
+    OSRAM128x64x4Flush();
+}
+
+//*****************************************************************************
+//
+//! The graphics library display structure that describes the driver for the
+//! OSRAM 128x64x4 panel.  All drawing goes into the off-screen frame buffer,
+//! so grlib contexts using this display must call GrFlush() to update the
+//! panel.
+//
+//*****************************************************************************
+const tDisplay g_sOSRAM128x64x4Display =
+{
+    sizeof(tDisplay),
+    0,
+    128,
+    64,
+    OSRAM128x64x4PixelDraw,
+    OSRAM128x64x4PixelDrawMultiple,
+    OSRAM128x64x4LineDrawH,
+    OSRAM128x64x4LineDrawV,
+    OSRAM128x64x4RectFill,
+    OSRAM128x64x4ColorTranslate,
+    OSRAM128x64x4DisplayFlush
+};
+
+//*****************************************************************************
+//
+// Close the Doxygen group.
+//! @}
+//
+//*****************************************************************************
+
+
+void DefaultBlockDraw(int x, int y, int w, int h)
+{
+    // 参数检查
+    if (x < 0 || x >= 128 || y < 0 || y >= 64) return;
+    if ((x & 1) != 0) x--;           // 保证 x 是偶数
+    if ((w & 1) != 0) w++;           // 保证宽度是偶数
+    if (x + w > 128) w = 128 - x;
+    if (y + h > 64)  h = 64 - y;
+
+    // 设置显示窗口（控制器已处于该状态的命令会被省略）
+    OSRAMSetWindow(x / 2, (x + w - 2) / 2, y, y + h - 1,
+                   g_pucOSRAM128x64x4HorizontalInc[1]);
+
+    // 每个像素填充为 0xF -> 白色，所有行一次连续发送
+    OSRAMWriteDataFill(0xFF, (w / 2) * h);
 }
\ No newline at end of file
@@ -29,6 +29,27 @@
 #ifndef __OSRAM128X64X4_H__
 #define __OSRAM128X64X4_H__
 
+//*****************************************************************************
+//
+// When set, the string drawing functions copy characters from a pre-expanded
+// 4-bit glyph table instead of expanding the 1-bit font for every character.
+//
+//*****************************************************************************
+#ifndef OSRAM_USE_GLYPH_ATLAS
+#define OSRAM_USE_GLYPH_ATLAS   1
+#endif
+
+//*****************************************************************************
+//
+// When set, both ways of building a character are compiled in and
+// OSRAM128x64x4GlyphAtlasEnable() selects one at run time, starting with the
+// one chosen by OSRAM_USE_GLYPH_ATLAS.  Used by the benchmark build.
+//
+//*****************************************************************************
+#ifndef OSRAM_COMPARE_GLYPH_PATHS
+#define OSRAM_COMPARE_GLYPH_PATHS   0
+#endif
+
 //*****************************************************************************
 //
 // Prototypes for the driver APIs.
@@ -49,9 +70,34 @@ extern void OSRAM128x64x4Enable(unsigned long ulFrequency);
 extern void OSRAM128x64x4Disable(void);
 extern void OSRAM128x64x4DisplayOn(void);
 extern void OSRAM128x64x4DisplayOff(void);
+extern void OSRAM128x64x4FrameClear(void);
+extern void OSRAM128x64x4FrameRectFill(unsigned long ulX,
+                                       unsigned long ulY,
+                                       unsigned long ulWidth,
+                                       unsigned long ulHeight,
+                                       unsigned char ucLevel);
+extern void OSRAM128x64x4FrameStringDraw(const char *pcStr,
+                                         unsigned long ulX,
+                                         unsigned long ulY,
+                                         unsigned char ucLevel);
+extern void OSRAM128x64x4Flush(void);
+#if OSRAM_COMPARE_GLYPH_PATHS
+extern void OSRAM128x64x4GlyphAtlasEnable(tBoolean bEnable);
+#endif
+extern void OSRAM128x64x4IntHandler(void);
 
 extern void DefaultBlockDraw(int x, int y, int w, int h);
 
+//*****************************************************************************
+//
+// The graphics library display driver, which draws into the frame buffer.
+// grlib.h must be included before this file to use it.
+//
+//*****************************************************************************
+#ifdef __GRLIB_H__
+extern const tDisplay g_sOSRAM128x64x4Display;
+#endif
+
 //*****************************************************************************
 //
 // The following macro(s) map old names for the OSRAM functions to the new
@@ -0,0 +1,171 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Runtime stack usage monitor as described in stackmon.h. */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/* Demo includes. */
+#include "stackmon.h"
+#include "uartprint.h"
+
+#define stackmonSTACK_SIZE		( configMINIMAL_STACK_SIZE * 2 )
+
+typedef struct xSTACK_MONITOR_ENTRY
+{
+	TaskHandle_t xTask;
+	configSTACK_DEPTH_TYPE uxStackDepth;	/* Words. */
+	UBaseType_t uxMinFree;					/* Lowest high water mark seen, in words. */
+	uint32_t ulLastGrowth;					/* Sample at which uxMinFree last went down. */
+} StackMonitorEntry_t;
+
+/*-----------------------------------------------------------*/
+
+/* The task that samples the high water marks. */
+static void prvStackMonitorTask( void *pvParameters );
+
+/* Take one sample of every monitored task. */
+static void prvSample( void );
+
+/*-----------------------------------------------------------*/
+
+static StackMonitorEntry_t xEntries[ stackmonMAX_TASKS ];
+static UBaseType_t uxEntryCount = 0;
+static uint32_t ulSamples = 0;
+
+static StaticTask_t xMonitorTaskTCB;
+static StackType_t xMonitorTaskStack[ stackmonSTACK_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+void vStackMonitorRegister( TaskHandle_t xTask, configSTACK_DEPTH_TYPE uxStackDepth )
+{
+	configASSERT( xTask );
+
+	taskENTER_CRITICAL();
+	{
+		if( uxEntryCount < stackmonMAX_TASKS )
+		{
+			xEntries[ uxEntryCount ].xTask = xTask;
+			xEntries[ uxEntryCount ].uxStackDepth = uxStackDepth;
+			xEntries[ uxEntryCount ].uxMinFree = uxStackDepth;
+			xEntries[ uxEntryCount ].ulLastGrowth = 0;
+			uxEntryCount++;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vStartStackMonitor( UBaseType_t uxPriority )
+{
+	xTaskCreateStatic( prvStackMonitorTask, "StackMon", stackmonSTACK_SIZE, NULL, uxPriority,
+					   xMonitorTaskStack, &xMonitorTaskTCB );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStackMonitorTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	/* The idle and timer service task handles only exist once the scheduler
+	has started, so these are registered here rather than by the caller. */
+	vStackMonitorRegister( xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE );
+	vStackMonitorRegister( xTimerGetTimerDaemonTaskHandle(), configTIMER_TASK_STACK_DEPTH );
+	vStackMonitorRegister( xTaskGetCurrentTaskHandle(), stackmonSTACK_SIZE );
+
+	for( ;; )
+	{
+		prvSample();
+		vTaskDelay( pdMS_TO_TICKS( stackmonSAMPLE_PERIOD_MS ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSample( void )
+{
+UBaseType_t uxIndex, uxFree;
+
+	ulSamples++;
+
+	for( uxIndex = 0; uxIndex < uxEntryCount; uxIndex++ )
+	{
+		/* The kernel's high water mark is already the lowest ever seen, but
+		noting when it last moved shows whether a soak run has been long
+		enough - a mark that is still going down is not yet the worst case. */
+		uxFree = uxTaskGetStackHighWaterMark( xEntries[ uxIndex ].xTask );
+
+		taskENTER_CRITICAL();
+		{
+			if( uxFree < xEntries[ uxIndex ].uxMinFree )
+			{
+				xEntries[ uxIndex ].uxMinFree = uxFree;
+				xEntries[ uxIndex ].ulLastGrowth = ulSamples;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vStackMonitorPrint( void )
+{
+StackMonitorEntry_t xCopy;
+UBaseType_t uxIndex, uxCount;
+uint32_t ulUsed, ulRecommended, ulSampleCount;
+
+	taskENTER_CRITICAL();
+	{
+		uxCount = uxEntryCount;
+		ulSampleCount = ulSamples;
+	}
+	taskEXIT_CRITICAL();
+
+	vUARTPrintf( "Stack usage after %u samples (words):\r\n", ( unsigned int ) ulSampleCount );
+
+	for( uxIndex = 0; uxIndex < uxCount; uxIndex++ )
+	{
+		taskENTER_CRITICAL();
+		{
+			xCopy = xEntries[ uxIndex ];
+		}
+		taskEXIT_CRITICAL();
+
+		ulUsed = ( uint32_t ) ( xCopy.uxStackDepth - xCopy.uxMinFree );
+		ulRecommended = ( ( ulUsed * ( 100UL + stackmonHEADROOM_PERCENT ) ) + 99UL ) / 100UL;
+		ulRecommended += stackmonOVERFLOW_GUARD_WORDS;
+
+		vUARTPrintf( "  %s: size %u, used %u, recommend %u, last grew at sample %u\r\n",
+					 pcTaskGetName( xCopy.xTask ), ( unsigned int ) xCopy.uxStackDepth,
+					 ( unsigned int ) ulUsed, ( unsigned int ) ulRecommended,
+					 ( unsigned int ) xCopy.ulLastGrowth );
+	}
+}
+/*-----------------------------------------------------------*/
+
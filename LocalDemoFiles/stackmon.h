@@ -0,0 +1,65 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef STACK_MONITOR_H
+#define STACK_MONITOR_H
+
+/*
+ * Runtime stack usage monitor.  A low priority task samples
+ * uxTaskGetStackHighWaterMark() for every registered task, plus the idle and
+ * timer service tasks, and vStackMonitorPrint() reports for each one the
+ * stack it was given, the most it has used, and a recommended size with
+ * stackmonHEADROOM_PERCENT spare.  Leave the game running for a while (a soak
+ * run) before reading the report, as it can only show the deepest call path
+ * that has actually happened.  The stack_report build target gives the
+ * static worst case to compare it with.  Built when -DSNAKE_STACK_ANALYSIS=ON.
+ */
+
+/* The most tasks that can be monitored, including the idle, timer service
+and monitor tasks. */
+#define stackmonMAX_TASKS				( 8 )
+
+/* How often the high water marks are sampled. */
+#define stackmonSAMPLE_PERIOD_MS		( 1000 )
+
+/* The spare stack to recommend on top of the most used, as a percentage. */
+#define stackmonHEADROOM_PERCENT		( 25 )
+
+/* configCHECK_FOR_STACK_OVERFLOW 2 checks the last 16 bytes of each stack
+are untouched, so those words are always added to the recommendation. */
+#define stackmonOVERFLOW_GUARD_WORDS	( 4 )
+
+/* Monitor xTask, which was created with a stack of uxStackDepth words. */
+void vStackMonitorRegister( TaskHandle_t xTask, configSTACK_DEPTH_TYPE uxStackDepth );
+
+/* Create the monitor task, which registers itself and the idle and timer
+service tasks. */
+void vStartStackMonitor( UBaseType_t uxPriority );
+
+/* Print the stack usage of each monitored task to UART0. */
+void vStackMonitorPrint( void );
+
+#endif
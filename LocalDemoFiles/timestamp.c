@@ -0,0 +1,69 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Free running cycle counter as described in timestamp.h. */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+
+/* Library includes. */
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "sysctl.h"
+#include "lmi_timer.h"
+
+/* Demo includes. */
+#include "timestamp.h"
+
+/* Misc defines. */
+#define timestampMAX_32BIT_VALUE		( 0xffffffffUL )
+#define timestampTIMER_1_COUNT_VALUE	( * ( ( volatile uint32_t * ) ( ( uint32_t ) TIMER1_BASE + 0x48UL ) ) )
+
+/*-----------------------------------------------------------*/
+
+void vTimestampInit( void )
+{
+static BaseType_t xInitialised = pdFALSE;
+
+	if( xInitialised == pdFALSE )
+	{
+		SysCtlPeripheralEnable( SYSCTL_PERIPH_TIMER1 );
+		TimerConfigure( TIMER1_BASE, TIMER_CFG_32_BIT_PER );
+		TimerLoadSet( TIMER1_BASE, TIMER_A, timestampMAX_32BIT_VALUE );
+		TimerEnable( TIMER1_BASE, TIMER_A );
+		xInitialised = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulTimestampGet( void )
+{
+	/* The timer counts down, so invert it to get a value that increases.  The
+	wrap from 0 to 0xffffffff then becomes a wrap from 0xffffffff to 0, which
+	unsigned subtraction handles. */
+	return ~timestampTIMER_1_COUNT_VALUE;
+}
+
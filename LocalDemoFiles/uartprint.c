@@ -0,0 +1,68 @@
+/*
+ * FreeRTOS V202212.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Polled UART0 output as described in uartprint.h. */
+
+/* Standard includes. */
+#include <stdarg.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+
+/* Library includes. */
+#include "hw_memmap.h"
+#include "hw_types.h"
+#include "uart.h"
+#include "ustdlib.h"
+
+/* Demo includes. */
+#include "uartprint.h"
+
+/*-----------------------------------------------------------*/
+
+void vUARTPrintString( const char *pcString )
+{
+	while( *pcString != 0x00 )
+	{
+		UARTCharPut( UART0_BASE, *pcString );
+		pcString++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vUARTPrintf( const char *pcFormat, ... )
+{
+char cLine[ uartprintMAX_LINE_LENGTH ];
+va_list xArgs;
+
+	va_start( xArgs, pcFormat );
+	uvsnprintf( cLine, sizeof( cLine ), pcFormat, xArgs );
+	va_end( xArgs );
+
+	vUARTPrintString( cLine );
+}
+/*-----------------------------------------------------------*/
+
@@ -531,6 +531,28 @@
         #define portTIMER_CALLBACK_ATTRIBUTE
     #endif /* portTIMER_CALLBACK_ATTRIBUTE */
 
+    #ifndef configUSE_TIMER_WHEEL
+        #define configUSE_TIMER_WHEEL    0
+    #endif
+
+    #ifndef configTIMER_WHEEL_SLOTS
+        #define configTIMER_WHEEL_SLOTS    64
+    #endif
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        #if ( ( configTIMER_WHEEL_SLOTS < 32 ) || ( ( configTIMER_WHEEL_SLOTS & ( configTIMER_WHEEL_SLOTS - 1 ) ) != 0 ) )
+            #error configTIMER_WHEEL_SLOTS must be a power of 2 and at least 32
+        #endif
+    #endif
+
+    #ifndef configTIMER_BATCH_SIZE
+        #define configTIMER_BATCH_SIZE    1
+    #endif
+
+    #if ( configTIMER_BATCH_SIZE < 1 )
+        #error configTIMER_BATCH_SIZE must be at least 1
+    #endif
+
 #endif /* configUSE_TIMERS */
 
 #ifndef portHAS_NESTED_INTERRUPTS
@@ -1412,6 +1434,102 @@
     #define traceRETURN_xQueueIsQueueFullFromISR( xReturn )
 #endif
 
+#ifndef traceENTER_xQueueSendMultiple
+    #define traceENTER_xQueueSendMultiple( xQueue, pvItems, uxCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueSendMultiple
+    #define traceRETURN_xQueueSendMultiple( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendMultipleFromISR
+    #define traceENTER_xQueueSendMultipleFromISR( xQueue, pvItems, uxCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueSendMultipleFromISR
+    #define traceRETURN_xQueueSendMultipleFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveMultiple
+    #define traceENTER_xQueueReceiveMultiple( xQueue, pvBuffer, uxCount, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveMultiple
+    #define traceRETURN_xQueueReceiveMultiple( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveMultipleFromISR
+    #define traceENTER_xQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxCount, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveMultipleFromISR
+    #define traceRETURN_xQueueReceiveMultipleFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendAcquire
+    #define traceENTER_xQueueSendAcquire( xQueue, ppvSlot, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueSendAcquire
+    #define traceRETURN_xQueueSendAcquire( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendCommit
+    #define traceENTER_xQueueSendCommit( xQueue, pvSlot )
+#endif
+
+#ifndef traceRETURN_xQueueSendCommit
+    #define traceRETURN_xQueueSendCommit( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendAcquireFromISR
+    #define traceENTER_xQueueSendAcquireFromISR( xQueue, ppvSlot )
+#endif
+
+#ifndef traceRETURN_xQueueSendAcquireFromISR
+    #define traceRETURN_xQueueSendAcquireFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueSendCommitFromISR
+    #define traceENTER_xQueueSendCommitFromISR( xQueue, pvSlot, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueSendCommitFromISR
+    #define traceRETURN_xQueueSendCommitFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveBorrow
+    #define traceENTER_xQueueReceiveBorrow( xQueue, ppvItem, xTicksToWait )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveBorrow
+    #define traceRETURN_xQueueReceiveBorrow( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveRelease
+    #define traceENTER_xQueueReceiveRelease( xQueue, pvItem )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveRelease
+    #define traceRETURN_xQueueReceiveRelease( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveBorrowFromISR
+    #define traceENTER_xQueueReceiveBorrowFromISR( xQueue, ppvItem )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveBorrowFromISR
+    #define traceRETURN_xQueueReceiveBorrowFromISR( xReturn )
+#endif
+
+#ifndef traceENTER_xQueueReceiveReleaseFromISR
+    #define traceENTER_xQueueReceiveReleaseFromISR( xQueue, pvItem, pxHigherPriorityTaskWoken )
+#endif
+
+#ifndef traceRETURN_xQueueReceiveReleaseFromISR
+    #define traceRETURN_xQueueReceiveReleaseFromISR( xReturn )
+#endif
+
 #ifndef traceENTER_xQueueCRSend
     #define traceENTER_xQueueCRSend( xQueue, pvItemToQueue, xTicksToWait )
 #endif
@@ -2718,6 +2836,20 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+#ifndef configUSE_TIMING_WHEEL
+    #define configUSE_TIMING_WHEEL    0
+#endif
+
+#ifndef configTIMING_WHEEL_SLOTS
+    #define configTIMING_WHEEL_SLOTS    64
+#endif
+
+#if ( configUSE_TIMING_WHEEL == 1 )
+    #if ( ( configTIMING_WHEEL_SLOTS < 32 ) || ( ( configTIMING_WHEEL_SLOTS & ( configTIMING_WHEEL_SLOTS - 1 ) ) != 0 ) )
+        #error configTIMING_WHEEL_SLOTS must be a power of 2 and at least 32
+    #endif
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -2734,6 +2866,10 @@
     #define configUSE_QUEUE_SETS    0
 #endif
 
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
 #ifndef portTASK_USES_FLOATING_POINT
     #define portTASK_USES_FLOATING_POINT()
 #endif
@@ -3261,6 +3397,10 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        UBaseType_t uxDummy10[ 2 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -541,7 +541,9 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
  * @return xQueueOverwrite() is a macro that calls xQueueGenericSend(), and
  * therefore has the same return values as xQueueSendToFront().  However, pdPASS
  * is the only value that can be returned because xQueueOverwrite() will write
- * to the queue even when the queue is already full.
+ * to the queue even when the queue is already full - unless the queue's slot
+ * is held by xQueueSendAcquire() or xQueueReceiveBorrow(), in which case
+ * errQUEUE_FULL is returned and the queue is left unchanged.
  *
  * Example usage:
  * @code{c}
@@ -914,6 +916,108 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultiple(
+ *                                 QueueHandle_t xQueue,
+ *                                 const void *pvItems,
+ *                                 UBaseType_t uxCount,
+ *                                 TickType_t xTicksToWait
+ *                             );
+ * @endcode
+ *
+ * Post up to uxCount items to the back of a queue in one call.  The items are
+ * copied into the queue from a single critical section, rather than from one
+ * critical section per item as when xQueueSend() is called for each of them.
+ * A task waiting to receive from the queue is unblocked for each item posted,
+ * but the calling task yields at most once.
+ *
+ * The call blocks, in the same way as xQueueSend(), only while the queue is
+ * full.  As soon as there is space for at least one item, as many items as
+ * there is space for are posted and the call returns.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxCount items, stored one after the other.
+ *
+ * @param uxCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.
+ *
+ * @return The number of items posted.  0 (errQUEUE_FULL) if no space became
+ * available in the block time.
+ *
+ * Example usage:
+ * @code{c}
+ * void vUARTTask( void *pvParameters )
+ * {
+ * char cReceived[ 16 ];
+ * UBaseType_t uxLength, uxSent;
+ *
+ *  for( ;; )
+ *  {
+ *      uxLength = uxReadUART( cReceived, sizeof( cReceived ) );
+ *
+ *      // Post all the characters, blocking while the queue is full.
+ *      for( uxSent = 0; uxSent < uxLength; )
+ *      {
+ *          uxSent += xQueueSendMultiple( xCharQueue, &( cReceived[ uxSent ] ), uxLength - uxSent, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItems,
+                               const UBaseType_t uxCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultiple(
+ *                                    QueueHandle_t xQueue,
+ *                                    void *pvBuffer,
+ *                                    UBaseType_t uxCount,
+ *                                    TickType_t xTicksToWait
+ *                                );
+ * @endcode
+ *
+ * Receive up to uxCount items from a queue in one call, from a single
+ * critical section.  A task waiting to send to the queue is unblocked for
+ * each item received, but the calling task yields at most once.
+ *
+ * The call blocks, in the same way as xQueueReceive(), only while the queue is
+ * empty.  As soon as the queue holds at least one item, as many items as are
+ * in the queue, up to uxCount, are received and the call returns.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxCount items.
+ * The items are stored one after the other in the order they were received.
+ *
+ * @param uxCount The largest number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of
+ * the call.
+ *
+ * @return The number of items received.  0 (errQUEUE_EMPTY) if no item was
+ * received in the block time.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  const UBaseType_t uxCount,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * @code{c}
@@ -1145,7 +1249,9 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
  * xQueueGenericSendFromISR(), and therefore has the same return values as
  * xQueueSendToFrontFromISR().  However, pdPASS is the only value that can be
  * returned because xQueueOverwriteFromISR() will write to the queue even when
- * the queue is already full.
+ * the queue is already full - unless the queue's slot is held by
+ * xQueueSendAcquire() or xQueueReceiveBorrow(), in which case errQUEUE_FULL is
+ * returned and the queue is left unchanged.
  *
  * Example usage:
  * @code{c}
@@ -1456,6 +1562,59 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultipleFromISR(
+ *                                        QueueHandle_t xQueue,
+ *                                        const void *pvItems,
+ *                                        UBaseType_t uxCount,
+ *                                        BaseType_t *pxHigherPriorityTaskWoken
+ *                                    );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be used from an interrupt
+ * service routine.  It posts as many of the items as there is space for
+ * without blocking, and sets *pxHigherPriorityTaskWoken to pdTRUE if doing so
+ * unblocked a task with a priority higher than that of the running task.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItems,
+                                      const UBaseType_t uxCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultipleFromISR(
+ *                                           QueueHandle_t xQueue,
+ *                                           void *pvBuffer,
+ *                                           UBaseType_t uxCount,
+ *                                           BaseType_t *pxHigherPriorityTaskWoken
+ *                                       );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be used from an interrupt
+ * service routine.  It receives as many of the items in the queue as will fit
+ * in the buffer without blocking, and sets *pxHigherPriorityTaskWoken to
+ * pdTRUE if doing so unblocked a task with a priority higher than that of the
+ * running task.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         const UBaseType_t uxCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from within an ISR, or within a critical section.
@@ -1464,6 +1623,210 @@ BaseType_t xQueueIsQueueEmptyFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FU
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendAcquire(
+ *                                QueueHandle_t xQueue,
+ *                                void **ppvSlot,
+ *                                TickType_t xTicksToWait
+ *                            );
+ * @endcode
+ *
+ * Reserve the slot at the back of a queue so the next item can be written
+ * straight into the queue storage area, rather than being built in a buffer
+ * and copied in by xQueueSend().  The item is not in the queue, and cannot be
+ * received, until the slot is passed to xQueueSendCommit().  A reserved slot
+ * counts as used, so the call blocks while the queue is full in the same way,
+ * and with the same priority ordering, as xQueueSend().
+ *
+ * More than one slot can be reserved at a time, but slots must be committed
+ * in the order in which they were reserved.  xQueueSendToBack() must not be
+ * used on the queue while a slot is reserved.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param ppvSlot Set to the start of the reserved slot, which is
+ * uxQueueGetQueueItemSize() bytes long.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue.
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * struct AMessage
+ * {
+ *  char ucMessageID;
+ *  char ucData[ 20 ];
+ * };
+ *
+ * void vATask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue;
+ * struct AMessage *pxMessage;
+ *
+ *  xQueue = xQueueCreate( 10, sizeof( struct AMessage ) );
+ *
+ *  // ...
+ *
+ *  if( xQueueSendAcquire( xQueue, ( void ** ) &pxMessage, ( TickType_t ) 10 ) == pdPASS )
+ *  {
+ *      // Fill in the message where it is stored in the queue.
+ *      pxMessage->ucMessageID = 1;
+ *      vFillData( pxMessage->ucData );
+ *
+ *      // Make the message available to the receiving task.
+ *      xQueueSendCommit( xQueue, pxMessage );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueSendAcquire xQueueSendAcquire
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendAcquire( QueueHandle_t xQueue,
+                              void ** const ppvSlot,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendCommit( QueueHandle_t xQueue, void *pvSlot );
+ * @endcode
+ *
+ * Add the item written into a slot reserved by xQueueSendAcquire() to the
+ * back of the queue, unblocking the highest priority task waiting to receive
+ * from the queue, if any.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param pvSlot The slot, which must be the oldest slot still reserved.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueSendCommit xQueueSendCommit
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendCommit( QueueHandle_t xQueue,
+                             void * const pvSlot ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendAcquireFromISR( QueueHandle_t xQueue, void **ppvSlot );
+ * BaseType_t xQueueSendCommitFromISR( QueueHandle_t xQueue, void *pvSlot, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Versions of xQueueSendAcquire() and xQueueSendCommit() that can be used
+ * from an interrupt service routine.  xQueueSendAcquireFromISR() does not
+ * block, and returns errQUEUE_FULL if the queue is full.
+ * xQueueSendCommitFromISR() sets *pxHigherPriorityTaskWoken to pdTRUE if
+ * committing the slot unblocked a task with a priority higher than that of
+ * the running task, in which case a context switch should be requested
+ * before the interrupt is exited.
+ *
+ * \defgroup xQueueSendAcquireFromISR xQueueSendAcquireFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendAcquireFromISR( QueueHandle_t xQueue,
+                                     void ** const ppvSlot ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueSendCommitFromISR( QueueHandle_t xQueue,
+                                    void * const pvSlot,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveBorrow(
+ *                                  QueueHandle_t xQueue,
+ *                                  void **ppvItem,
+ *                                  TickType_t xTicksToWait
+ *                              );
+ * @endcode
+ *
+ * Remove the item at the front of a queue without copying it out.  The item
+ * is read where it is stored in the queue, and its slot cannot be reused
+ * until the item is passed to xQueueReceiveRelease().  The call blocks while
+ * the queue is empty in the same way, and with the same priority ordering, as
+ * xQueueReceive().
+ *
+ * More than one item can be borrowed at a time, but items must be released in
+ * the order in which they were borrowed.  xQueueReceive() and
+ * xQueueSendToFront() must not be used on the queue while an item is borrowed.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param ppvItem Set to the start of the item, which is
+ * uxQueueGetQueueItemSize() bytes long.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item to receive should the queue be empty at the time of
+ * the call.
+ *
+ * @return pdPASS if an item was borrowed, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueueReceiveBorrow xQueueReceiveBorrow
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveBorrow( QueueHandle_t xQueue,
+                                void ** const ppvItem,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveRelease( QueueHandle_t xQueue, const void *pvItem );
+ * @endcode
+ *
+ * Free the slot of an item borrowed by xQueueReceiveBorrow(), unblocking the
+ * highest priority task waiting to send to the queue, if any.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param pvItem The item, which must be the oldest item still borrowed.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xQueueReceiveRelease xQueueReceiveRelease
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveRelease( QueueHandle_t xQueue,
+                                 const void * const pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveBorrowFromISR( QueueHandle_t xQueue, void **ppvItem );
+ * BaseType_t xQueueReceiveReleaseFromISR( QueueHandle_t xQueue, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Versions of xQueueReceiveBorrow() and xQueueReceiveRelease() that can be
+ * used from an interrupt service routine.  xQueueReceiveBorrowFromISR() does
+ * not block, and returns pdFAIL if the queue is empty.
+ * xQueueReceiveReleaseFromISR() sets *pxHigherPriorityTaskWoken to pdTRUE if
+ * releasing the item unblocked a task with a priority higher than that of the
+ * running task.
+ *
+ * \defgroup xQueueReceiveBorrowFromISR xQueueReceiveBorrowFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveBorrowFromISR( QueueHandle_t xQueue,
+                                       void ** const ppvItem ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReceiveReleaseFromISR( QueueHandle_t xQueue,
+                                        const void * const pvItem,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
 #if ( configUSE_CO_ROUTINES == 1 )
 
 /*
@@ -95,6 +95,24 @@ typedef struct SemaphoreData
     #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 #endif
 
+/* The number of slots of the queue storage area that cannot be written to -
+ * those holding items plus, when zero copy is used, those handed out to
+ * writers and readers. */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueSLOTS_IN_USE( pxQueue )    ( ( pxQueue )->uxMessagesWaiting + ( pxQueue )->uxSlotsAcquired + ( pxQueue )->uxItemsBorrowed )
+#else
+    #define queueSLOTS_IN_USE( pxQueue )    ( ( pxQueue )->uxMessagesWaiting )
+#endif
+
+/* An overwrite may only replace an item that is held in the queue - never a
+ * slot that has been handed out to a writer or reader, as the later commit or
+ * release would then leave the queue with more items than it has slots. */
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    #define queueCAN_OVERWRITE( pxQueue )    ( ( ( pxQueue )->uxSlotsAcquired == 0U ) && ( ( pxQueue )->uxItemsBorrowed == 0U ) )
+#else
+    #define queueCAN_OVERWRITE( pxQueue )    ( pdTRUE )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -133,6 +151,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        UBaseType_t uxSlotsAcquired; /**< The number of slots handed out by xQueueSendAcquire() that have not been committed yet.  They follow pcWriteTo. */
+        UBaseType_t uxItemsBorrowed; /**< The number of items handed out by xQueueReceiveBorrow() that have not been released yet.  They end at pcReadFrom. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -210,6 +233,46 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copy a number of items to the back of a queue, or from the front of a
+ * queue.  The caller has already checked there is enough space, or enough
+ * items.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItems,
+                                 const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   int8_t * const pcBuffer,
+                                   const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock up to uxCount tasks, one for each item added to or removed from a
+ * queue, from a critical section.
+ *
+ * @return pdTRUE if any of the tasks has a priority higher than that of the
+ * running task, otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockTasksWaitingOnList( List_t * const pxEventList,
+                                                const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue,
+                                                   const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Hand out the next free slot of the queue storage area to a writer, or the
+ * next item to a reader, and take them back again.  Slots are committed, and
+ * items released, in the order in which they were handed out.  Called from a
+ * critical section.
+ */
+    static void * prvAcquireSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvCommitSlot( Queue_t * const pxQueue,
+                               const void * const pvSlot ) PRIVILEGED_FUNCTION;
+    static void * prvBorrowItem( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvReleaseItem( Queue_t * const pxQueue,
+                                const void * const pvItem ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -324,6 +387,14 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                /* Slots and items still held are lost. */
+                pxQueue->uxSlotsAcquired = ( UBaseType_t ) 0U;
+                pxQueue->uxItemsBorrowed = ( UBaseType_t ) 0U;
+            }
+            #endif
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -973,8 +1044,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             /* Is there room on the queue now?  The running task must be the
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
-             * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+             * queue is full, unless its only slot is held by a zero copy writer
+             * or reader. */
+            if( ( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength ) || ( ( xCopyPosition == queueOVERWRITE ) && queueCAN_OVERWRITE( pxQueue ) ) )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -1205,7 +1277,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     /* coverity[misra_c_2012_directive_4_7_violation] */
     uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( ( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength ) || ( ( xCopyPosition == queueOVERWRITE ) && queueCAN_OVERWRITE( pxQueue ) ) )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1336,6 +1408,207 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItems,
+                               const UBaseType_t uxCount,
+                               TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxSent;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueSendMultiple( xQueue, pvItems, uxCount, xTicksToWait );
+
+    configASSERT( pxQueue );
+    configASSERT( pvItems );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* As xQueueGenericSend() when sending to the back, except that as many of
+     * the items as there is space for are sent at once. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxSent = ( UBaseType_t ) ( pxQueue->uxLength - queueSLOTS_IN_USE( pxQueue ) );
+
+            if( ( uxSent > ( UBaseType_t ) 0 ) || ( uxCount == ( UBaseType_t ) 0 ) )
+            {
+                if( uxSent > uxCount )
+                {
+                    uxSent = uxCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceQUEUE_SEND( pxQueue );
+                prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxSent );
+
+                /* Unblock a task for each item, but yield no more than once. */
+                if( prvUnblockTasksWaitingToReceive( pxQueue, uxSent ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+
+                traceRETURN_xQueueSendMultiple( ( BaseType_t ) uxSent );
+
+                return ( BaseType_t ) uxSent;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    traceRETURN_xQueueSendMultiple( errQUEUE_FULL );
+
+                    return errQUEUE_FULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            traceRETURN_xQueueSendMultiple( errQUEUE_FULL );
+
+            return errQUEUE_FULL;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItems,
+                                      const UBaseType_t uxCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSent;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueSendMultipleFromISR( xQueue, pvItems, uxCount, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( pvItems );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    {
+        uxSent = ( UBaseType_t ) ( pxQueue->uxLength - queueSLOTS_IN_USE( pxQueue ) );
+
+        if( uxSent > uxCount )
+        {
+            uxSent = uxCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxSent > ( UBaseType_t ) 0 )
+        {
+            int8_t cTxLock = pxQueue->cTxLock;
+            UBaseType_t uxItem;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxSent );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( ( prvUnblockTasksWaitingToReceive( pxQueue, uxSent ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Count every item so the task that unlocks the queue can
+                 * unblock a task for each of them. */
+                for( uxItem = ( UBaseType_t ) 0; uxItem < uxSent; uxItem++ )
+                {
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    cTxLock = pxQueue->cTxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    traceRETURN_xQueueSendMultipleFromISR( ( BaseType_t ) uxSent );
+
+    return ( BaseType_t ) uxSent;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                               BaseType_t * const pxHigherPriorityTaskWoken )
 {
@@ -1543,6 +1816,14 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
+                #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+                {
+                    /* Freeing the slot of this item would free the slots of
+                     * any borrowed items before they have been released. */
+                    configASSERT( pxQueue->uxItemsBorrowed == 0U );
+                }
+                #endif
+
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_RECEIVE( pxQueue );
@@ -2085,6 +2366,13 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
 
             traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                /* As in xQueueReceive(). */
+                configASSERT( pxQueue->uxItemsBorrowed == 0U );
+            }
+            #endif
+
             prvCopyDataFromQueue( pxQueue, pvBuffer );
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( uxMessagesWaiting - ( UBaseType_t ) 1 );
 
@@ -2142,67 +2430,824 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  const UBaseType_t uxCount,
+                                  TickType_t xTicksToWait )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxReceived;
     Queue_t * const pxQueue = xQueue;
 
-    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+    traceENTER_xQueueReceiveMultiple( xQueue, pvBuffer, uxCount, xTicksToWait );
 
     configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
-
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    configASSERT( pvBuffer );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
 
-    /* MISRA Ref 4.7.1 [Return value shall be checked] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
-    /* coverity[misra_c_2012_directive_4_7_violation] */
-    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    /* As xQueueReceive(), except that as many of the items in the queue as
+     * will fit in the buffer are received at once. */
+    for( ; ; )
     {
-        /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        taskENTER_CRITICAL();
         {
-            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+            uxReceived = pxQueue->uxMessagesWaiting;
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            if( ( uxReceived > ( UBaseType_t ) 0 ) || ( uxCount == ( UBaseType_t ) 0 ) )
+            {
+                if( uxReceived > uxCount )
+                {
+                    uxReceived = uxCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-            xReturn = pdPASS;
-        }
-        else
-        {
-            xReturn = pdFAIL;
-            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
-        }
-    }
-    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+                prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxReceived );
+                traceQUEUE_RECEIVE( pxQueue );
 
-    traceRETURN_xQueuePeekFromISR( xReturn );
+                /* Unblock a task for each slot freed, but yield no more than
+                 * once. */
+                if( prvUnblockTasksWaitingOnList( &( pxQueue->xTasksWaitingToSend ), uxReceived ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+                taskEXIT_CRITICAL();
+
+                traceRETURN_xQueueReceiveMultiple( ( BaseType_t ) uxReceived );
+
+                return ( BaseType_t ) uxReceived;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueReceiveMultiple( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    taskYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                traceRETURN_xQueueReceiveMultiple( errQUEUE_EMPTY );
+
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         const UBaseType_t uxCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxReceived;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueueReceiveMultipleFromISR( xQueue, pvBuffer, uxCount, pxHigherPriorityTaskWoken );
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    {
+        uxReceived = pxQueue->uxMessagesWaiting;
+
+        if( uxReceived > uxCount )
+        {
+            uxReceived = uxCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( uxReceived > ( UBaseType_t ) 0 )
+        {
+            int8_t cRxLock = pxQueue->cRxLock;
+            UBaseType_t uxItem;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxReceived );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know how much space was freed while the queue was locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( ( prvUnblockTasksWaitingOnList( &( pxQueue->xTasksWaitingToSend ), uxReceived ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                for( uxItem = ( UBaseType_t ) 0; uxItem < uxReceived; uxItem++ )
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    cRxLock = pxQueue->cRxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    traceRETURN_xQueueReceiveMultipleFromISR( ( BaseType_t ) uxReceived );
+
+    return ( BaseType_t ) uxReceived;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    int8_t * pcOriginalReadPosition;
+    Queue_t * const pxQueue = xQueue;
+
+    traceENTER_xQueuePeekFromISR( xQueue, pvBuffer );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    /* MISRA Ref 4.7.1 [Return value shall be checked] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+    /* coverity[misra_c_2012_directive_4_7_violation] */
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+    {
+        /* Cannot block in an ISR, so check there is data available. */
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+            /* Remember the read position so it can be reset as nothing is
+             * actually being removed from the queue. */
+            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    traceRETURN_xQueuePeekFromISR( xReturn );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    BaseType_t xQueueSendAcquire( QueueHandle_t xQueue,
+                                  void ** const ppvSlot,
+                                  TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSendAcquire( xQueue, ppvSlot, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /* As xQueueGenericSend(), except that the slot is only reserved here.
+         * Nothing is added to the queue, so no task is unblocked, until the
+         * slot is committed. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength )
+                {
+                    *ppvSlot = prvAcquireSlot( pxQueue );
+
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueSendAcquire( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        traceRETURN_xQueueSendAcquire( errQUEUE_FULL );
+
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                traceRETURN_xQueueSendAcquire( errQUEUE_FULL );
+
+                return errQUEUE_FULL;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSendCommit( QueueHandle_t xQueue,
+                                 void * const pvSlot )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSendCommit( xQueue, pvSlot );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            traceQUEUE_SEND( pxQueue );
+            prvCommitSlot( pxQueue, pvSlot );
+
+            /* The item is now in the queue, so wake a task waiting for it in
+             * the same way as xQueueGenericSend(). */
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                if( pxQueue->pxQueueSetContainer != NULL )
+                {
+                    if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* configUSE_QUEUE_SETS */
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SETS */
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueSendCommit( pdPASS );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSendAcquireFromISR( QueueHandle_t xQueue,
+                                         void ** const ppvSlot )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueSendAcquireFromISR( xQueue, ppvSlot );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( queueSLOTS_IN_USE( pxQueue ) < pxQueue->uxLength )
+            {
+                *ppvSlot = prvAcquireSlot( pxQueue );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+                xReturn = errQUEUE_FULL;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueSendAcquireFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueSendCommitFromISR( QueueHandle_t xQueue,
+                                        void * const pvSlot,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xTaskWoken = pdFALSE;
+
+        traceENTER_xQueueSendCommitFromISR( xQueue, pvSlot, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            prvCommitSlot( pxQueue, pvSlot );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        xTaskWoken = prvNotifyQueueSetContainer( pxQueue );
+                    }
+                    else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        xTaskWoken = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        xTaskWoken = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( ( xTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+        {
+            *pxHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xQueueSendCommitFromISR( pdPASS );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReceiveBorrow( QueueHandle_t xQueue,
+                                    void ** const ppvItem,
+                                    TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReceiveBorrow( xQueue, ppvItem, xTicksToWait );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /* As xQueueReceive(), except that the slot of the item stays in use,
+         * so no task waiting to send is unblocked, until it is released. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    *ppvItem = prvBorrowItem( pxQueue );
+                    traceQUEUE_RECEIVE( pxQueue );
+
+                    taskEXIT_CRITICAL();
+
+                    traceRETURN_xQueueReceiveBorrow( pdPASS );
+
+                    return pdPASS;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        traceRETURN_xQueueReceiveBorrow( errQUEUE_EMPTY );
+
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        taskYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceRETURN_xQueueReceiveBorrow( errQUEUE_EMPTY );
+
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReceiveRelease( QueueHandle_t xQueue,
+                                     const void * const pvItem )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReceiveRelease( xQueue, pvItem );
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            prvReleaseItem( pxQueue, pvItem );
+
+            /* There is now space in the queue, so wake a task waiting to send
+             * in the same way as xQueueReceive(). */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_xQueueReceiveRelease( pdPASS );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReceiveBorrowFromISR( QueueHandle_t xQueue,
+                                           void ** const ppvItem )
+    {
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReceiveBorrowFromISR( xQueue, ppvItem );
+
+        configASSERT( pxQueue );
+        configASSERT( ppvItem );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        /* See the comment in xQueueGenericSendFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+                *ppvItem = prvBorrowItem( pxQueue );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueReceiveBorrowFromISR( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReceiveReleaseFromISR( QueueHandle_t xQueue,
+                                            const void * const pvItem,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        Queue_t * const pxQueue = xQueue;
+
+        traceENTER_xQueueReceiveReleaseFromISR( xQueue, pvItem, pxHigherPriorityTaskWoken );
+
+        configASSERT( pxQueue );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* MISRA Ref 4.7.1 [Return value shall be checked] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#dir-47 */
+        /* coverity[misra_c_2012_directive_4_7_violation] */
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            prvReleaseItem( pxQueue, pvItem );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that space was freed while the queue was locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceRETURN_xQueueReceiveReleaseFromISR( pdPASS );
+
+        return pdPASS;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
 
 UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
 {
@@ -2235,7 +3280,7 @@ UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
 
     portBASE_TYPE_ENTER_CRITICAL();
     {
-        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - pxQueue->uxMessagesWaiting );
+        uxReturn = ( UBaseType_t ) ( pxQueue->uxLength - queueSLOTS_IN_USE( pxQueue ) );
     }
     portBASE_TYPE_EXIT_CRITICAL();
 
@@ -2406,6 +3451,16 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 
     /* This function is called from a critical section. */
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    {
+        /* An item copied to the back would land in a slot handed out by
+         * xQueueSendAcquire(), one copied to the front in an item handed out
+         * by xQueueReceiveBorrow(), and an overwrite in either. */
+        configASSERT( ( xPosition == queueSEND_TO_BACK ) ? ( pxQueue->uxSlotsAcquired == 0U ) : ( pxQueue->uxItemsBorrowed == 0U ) );
+        configASSERT( ( xPosition != queueOVERWRITE ) || ( pxQueue->uxSlotsAcquired == 0U ) );
+    }
+    #endif
+
     uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
     if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
@@ -2501,6 +3556,287 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItems,
+                                 const UBaseType_t uxCount )
+{
+    size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+    size_t xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+    /* This function is called from a critical section. */
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    {
+        /* As in prvCopyDataToQueue(). */
+        configASSERT( pxQueue->uxSlotsAcquired == 0U );
+    }
+    #endif
+
+    /* The items are copied to the back of the queue with at most two copies,
+     * the second for any items that wrap round to the start of the storage
+     * area. */
+    if( xFirstBytes > xBytes )
+    {
+        xFirstBytes = xBytes;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirstBytes );
+    xBytes -= xFirstBytes;
+    pxQueue->pcWriteTo += xFirstBytes;
+
+    if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+    {
+        ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) &( pcItems[ xFirstBytes ] ), xBytes );
+        pxQueue->pcWriteTo = pxQueue->pcHead + xBytes;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + uxCount );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                   int8_t * const pcBuffer,
+                                   const UBaseType_t uxCount )
+{
+    size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+    int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+    size_t xFirstBytes;
+
+    /* This function is called from a critical section. */
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+    {
+        /* As in xQueueReceive(). */
+        configASSERT( pxQueue->uxItemsBorrowed == 0U );
+    }
+    #endif
+
+    /* pcReadFrom points to the last item read, so the first item to copy is
+     * the one after it. */
+    if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+    {
+        pcReadFrom = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+
+    if( xFirstBytes > xBytes )
+    {
+        xFirstBytes = xBytes;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xFirstBytes );
+    xBytes -= xFirstBytes;
+    pcReadFrom += xFirstBytes;
+
+    if( xBytes > ( size_t ) 0 )
+    {
+        ( void ) memcpy( ( void * ) &( pcBuffer[ xFirstBytes ] ), ( const void * ) pxQueue->pcHead, xBytes );
+        pcReadFrom = pxQueue->pcHead + xBytes;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( uxCount > ( UBaseType_t ) 0 )
+    {
+        pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - uxCount );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingOnList( List_t * const pxEventList,
+                                                const UBaseType_t uxCount )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxUnblocked;
+
+    for( uxUnblocked = ( UBaseType_t ) 0; uxUnblocked < uxCount; uxUnblocked++ )
+    {
+        if( listLIST_IS_EMPTY( pxEventList ) != pdFALSE )
+        {
+            break;
+        }
+        else if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+        {
+            xHigherPriorityTaskWoken = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue,
+                                                   const UBaseType_t uxCount )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        UBaseType_t uxItem;
+
+        if( pxQueue->pxQueueSetContainer != NULL )
+        {
+            /* The queue set holds the handle of the queue once for each item
+             * in the queue. */
+            for( uxItem = ( UBaseType_t ) 0; uxItem < uxCount; uxItem++ )
+            {
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            xHigherPriorityTaskWoken = prvUnblockTasksWaitingOnList( &( pxQueue->xTasksWaitingToReceive ), uxCount );
+        }
+    }
+    #else /* configUSE_QUEUE_SETS */
+    {
+        xHigherPriorityTaskWoken = prvUnblockTasksWaitingOnList( &( pxQueue->xTasksWaitingToReceive ), uxCount );
+    }
+    #endif /* configUSE_QUEUE_SETS */
+
+    return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static void * prvAcquireSlot( Queue_t * const pxQueue )
+    {
+        const size_t xStorageSize = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcHead );
+        size_t xOffset;
+
+        /* Slots already acquired but not committed follow pcWriteTo. */
+        xOffset = ( size_t ) ( pxQueue->pcWriteTo - pxQueue->pcHead ) + ( ( size_t ) pxQueue->uxSlotsAcquired * ( size_t ) pxQueue->uxItemSize );
+
+        if( xOffset >= xStorageSize )
+        {
+            xOffset -= xStorageSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxSlotsAcquired++;
+
+        return ( void * ) ( pxQueue->pcHead + xOffset );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCommitSlot( Queue_t * const pxQueue,
+                               const void * const pvSlot )
+    {
+        /* Only the oldest acquired slot can be committed, as committing it
+         * makes the slot at pcWriteTo the last item in the queue. */
+        configASSERT( pxQueue->uxSlotsAcquired > ( UBaseType_t ) 0U );
+        configASSERT( pvSlot == ( const void * ) pxQueue->pcWriteTo );
+        ( void ) pvSlot;
+
+        pxQueue->pcWriteTo += pxQueue->uxItemSize;
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxSlotsAcquired--;
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1 );
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvBorrowItem( Queue_t * const pxQueue )
+    {
+        /* Move pcReadFrom on as prvCopyDataFromQueue() does, but leave the
+         * item where it is. */
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail )
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->uxMessagesWaiting = ( UBaseType_t ) ( pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1 );
+        pxQueue->uxItemsBorrowed++;
+
+        return ( void * ) pxQueue->u.xQueue.pcReadFrom;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReleaseItem( Queue_t * const pxQueue,
+                                const void * const pvItem )
+    {
+        const size_t xStorageSize = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcHead );
+        size_t xOffset;
+
+        configASSERT( pxQueue->uxItemsBorrowed > ( UBaseType_t ) 0U );
+
+        /* Only the oldest borrowed item can be released, as the slots that
+         * are free again have to follow on from pcWriteTo. */
+        xOffset = ( size_t ) ( pxQueue->u.xQueue.pcReadFrom - pxQueue->pcHead ) + xStorageSize - ( ( size_t ) ( pxQueue->uxItemsBorrowed - ( UBaseType_t ) 1U ) * ( size_t ) pxQueue->uxItemSize );
+
+        if( xOffset >= xStorageSize )
+        {
+            xOffset -= xStorageSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        configASSERT( pvItem == ( const void * ) ( pxQueue->pcHead + xOffset ) );
+        ( void ) pvItem;
+        ( void ) xOffset;
+
+        pxQueue->uxItemsBorrowed--;
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2672,7 +4008,7 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( queueSLOTS_IN_USE( pxQueue ) == pxQueue->uxLength )
         {
             xReturn = pdTRUE;
         }
@@ -2696,7 +4032,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( queueSLOTS_IN_USE( pxQueue ) == pxQueue->uxLength )
     {
         xReturn = pdTRUE;
     }
@@ -259,6 +259,34 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/* The wheel slot that holds tasks due at a given tick, and the first tick of
+ * the revolution of the wheel in which a given tick falls. */
+    #define taskWHEEL_SLOT_MASK                     ( ( TickType_t ) configTIMING_WHEEL_SLOTS - ( TickType_t ) 1U )
+    #define taskWHEEL_REVOLUTION_START( xTime )    ( ( xTime ) & ~taskWHEEL_SLOT_MASK )
+
+/* Append a delayed task's state list item to the wheel slot for its wake time
+ * and mark the slot as occupied. */
+    #define taskWHEEL_INSERT_IN_SLOT( pxListItem, xTimeToWake )                                   \
+    do {                                                                                         \
+        const UBaseType_t uxSlotToUse = ( UBaseType_t ) ( ( xTimeToWake ) & taskWHEEL_SLOT_MASK ); \
+        listINSERT_END( &( xDelayedTaskWheel[ uxSlotToUse ] ), ( pxListItem ) );                   \
+        ulDelayedTaskWheelSlotMap[ uxSlotToUse >> 5 ] |= ( uint32_t ) 1U << ( uxSlotToUse & 31U );  \
+    } while( 0 )
+
+/* The timing wheel is indexed by the low bits of the wake time so it does not
+ * need switching when the tick count overflows.  xNextTaskUnblockTime is left
+ * at portMAX_DELAY while the next wake time lies beyond the overflow, so set it
+ * to 0 to have the wheel examined again from the slot for tick 0. */
+    #define taskSWITCH_DELAYED_LISTS()                                \
+    do {                                                              \
+        xNumOfOverflows = ( BaseType_t ) ( xNumOfOverflows + 1 );     \
+        xNextTaskUnblockTime = ( TickType_t ) 0U;                     \
+    } while( 0 )
+
+#else /* if ( configUSE_TIMING_WHEEL == 1 ) */
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
 #define taskSWITCH_DELAYED_LISTS()                                                \
@@ -275,6 +303,8 @@
         prvResetNextTaskUnblockTime();                                            \
     } while( 0 )
 
+#endif /* if ( configUSE_TIMING_WHEEL == 1 ) */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -479,6 +509,22 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Po
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+/* When configUSE_TIMING_WHEEL is 1 delayed tasks are held on a hashed timing
+ * wheel instead of the two sorted delayed lists above, which then remain empty.
+ * A task due within configTIMING_WHEEL_SLOTS ticks is appended to the slot
+ * selected by the low bits of its wake time, so entering and leaving the
+ * Blocked state no longer depends on the number of blocked tasks.  Tasks due
+ * further ahead wait, unsorted, on the overflow list until the revolution of
+ * the wheel in which they fall due, when they are cascaded into their slot. */
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configTIMING_WHEEL_SLOTS ];                /**< Delayed tasks due within one revolution of the wheel. */
+    PRIVILEGED_DATA static List_t xDelayedTaskWheelOverflow;                                    /**< Delayed tasks due beyond the current revolution of the wheel. */
+    PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelSlotMap[ configTIMING_WHEEL_SLOTS / 32U ]; /**< A set bit marks a slot that may hold tasks, so empty slots can be skipped 32 at a time. */
+    PRIVILEGED_DATA static TickType_t xDelayedTaskWheelCascadeTime;                             /**< The tick at which the overflow list is next scanned for tasks due within one revolution. */
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /**< Tasks that have been deleted - but their memory not yet freed. */
@@ -698,6 +744,31 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Timing wheel helpers.  prvWheelInsert() places a delayed task in the slot
+ * for its wake time, or on the overflow list if it is not due within one
+ * revolution of the wheel.  prvWheelGetDueTask() returns a task that is due to
+ * leave the Blocked state at xConstTickCount, or NULL if no more tasks are due,
+ * first calling prvWheelCascade() to move tasks from the overflow list into
+ * their slots if the revolution in which the earliest of them is due has
+ * started.
+ * prvWheelNextUnblockTime() returns the next tick after xConstTickCount at which
+ * the wheel needs attention.
+ */
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+    static void prvWheelInsert( ListItem_t * pxStateListItem,
+                                TickType_t xTimeToWake,
+                                TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+    static void prvWheelCascade( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+    static TCB_t * prvWheelGetDueTask( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+    static TickType_t prvWheelNextUnblockTime( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -2550,6 +2621,16 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 eReturn = eBlocked;
             }
 
+            #if ( configUSE_TIMING_WHEEL == 1 )
+                else if( ( ( pxStateList >= &( xDelayedTaskWheel[ 0 ] ) ) && ( pxStateList <= &( xDelayedTaskWheel[ configTIMING_WHEEL_SLOTS - 1U ] ) ) ) ||
+                         ( pxStateList == &xDelayedTaskWheelOverflow ) )
+                {
+                    /* The task being queried is referenced from the timing
+                     * wheel. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
                 else if( pxStateList == &xSuspendedTaskList )
                 {
@@ -4350,6 +4431,22 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                 pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
             }
 
+            #if ( configUSE_TIMING_WHEEL == 1 )
+            {
+                UBaseType_t uxSlot;
+
+                for( uxSlot = 0U; ( uxSlot < ( UBaseType_t ) configTIMING_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxSlot ] ), pcNameToQuery );
+                }
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &xDelayedTaskWheelOverflow, pcNameToQuery );
+                }
+            }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
             {
                 if( pxTCB == NULL )
@@ -4463,6 +4560,19 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                 uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked ) );
                 uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked ) );
 
+                #if ( configUSE_TIMING_WHEEL == 1 )
+                {
+                    UBaseType_t uxSlot;
+
+                    for( uxSlot = 0U; uxSlot < ( UBaseType_t ) configTIMING_WHEEL_SLOTS; uxSlot++ )
+                    {
+                        uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxSlot ] ), eBlocked ) );
+                    }
+
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xDelayedTaskWheelOverflow, eBlocked ) );
+                }
+                #endif
+
                 #if ( INCLUDE_vTaskDelete == 1 )
                 {
                     /* Fill in an TaskStatus_t structure with information on
@@ -4725,7 +4835,10 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 BaseType_t xTaskIncrementTick( void )
 {
     TCB_t * pxTCB;
-    TickType_t xItemValue;
+
+    #if ( configUSE_TIMING_WHEEL == 0 )
+        TickType_t xItemValue;
+    #endif
     BaseType_t xSwitchRequired = pdFALSE;
 
     traceENTER_xTaskIncrementTick();
@@ -4766,92 +4879,114 @@ BaseType_t xTaskIncrementTick( void )
         {
             for( ; ; )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                #if ( configUSE_TIMING_WHEEL == 1 )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY;
-                    break;
-                }
-                else
-                {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    /* MISRA Ref 11.5.3 [Void pointer assignment] */
-                    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-                    /* coverity[misra_c_2012_rule_11_5_violation] */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+                    /* Every task in the slot for this tick is due now, so
+                     * there is no wake time to compare.  Once the slot is
+                     * empty find the next tick at which the wheel needs
+                     * attention. */
+                    pxTCB = prvWheelGetDueTask( xConstTickCount );
 
-                    if( xConstTickCount < xItemValue )
+                    if( pxTCB == NULL )
                     {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
+                        xNextTaskUnblockTime = prvWheelNextUnblockTime( xConstTickCount );
                         break;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                }
+                #else /* if ( configUSE_TIMING_WHEEL == 1 ) */
+                {
+                    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
                     {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                         * to the maximum possible value so it is extremely
+                         * unlikely that the
+                         * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                         * next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY;
+                        break;
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The delayed list is not empty, get the value of the
+                         * item at the head of the delayed list.  This is the time
+                         * at which the task at the head of the delayed list must
+                         * be removed from the Blocked state. */
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+                        xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                        if( xConstTickCount < xItemValue )
+                        {
+                            /* It is not time to unblock this item yet, but the
+                             * item value is the time at which the task at the head
+                             * of the blocked list must be removed from the Blocked
+                             * state -  so record the item value in
+                             * xNextTaskUnblockTime. */
+                            xNextTaskUnblockTime = xItemValue;
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
+                }
+                #endif /* if ( configUSE_TIMING_WHEEL == 1 ) */
 
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
+                /* It is time to remove the item from the Blocked state. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
 
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
+                /* Is the task waiting on an event also?  If so remove
+                 * it from the event list. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Place the unblocked task into the appropriate ready
+                 * list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate
+                 * context switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
                     {
-                        #if ( configNUMBER_OF_CORES == 1 )
+                        /* Preemption is on, but a context switch should
+                         * only be performed if the unblocked task's
+                         * priority is higher than the currently executing
+                         * task.
+                         * The case of equal priority tasks sharing
+                         * processing time (which happens when both
+                         * preemption and time slicing are on) is
+                         * handled below.*/
+                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
                         {
-                            /* Preemption is on, but a context switch should
-                             * only be performed if the unblocked task's
-                             * priority is higher than the currently executing
-                             * task.
-                             * The case of equal priority tasks sharing
-                             * processing time (which happens when both
-                             * preemption and time slicing are on) is
-                             * handled below.*/
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                            {
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            xSwitchRequired = pdTRUE;
                         }
-                        #else /* #if( configNUMBER_OF_CORES == 1 ) */
+                        else
                         {
-                            prvYieldForTask( pxTCB );
+                            mtCOVERAGE_TEST_MARKER();
                         }
-                        #endif /* #if( configNUMBER_OF_CORES == 1 ) */
                     }
-                    #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+                    #else /* #if( configNUMBER_OF_CORES == 1 ) */
+                    {
+                        prvYieldForTask( pxTCB );
+                    }
+                    #endif /* #if( configNUMBER_OF_CORES == 1 ) */
                 }
+                #endif /* #if ( configUSE_PREEMPTION == 1 ) */
             }
         }
 
@@ -6077,6 +6212,24 @@ static void prvInitialiseTaskLists( void )
     vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
 
+    #if ( configUSE_TIMING_WHEEL == 1 )
+    {
+        UBaseType_t uxSlot;
+
+        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configTIMING_WHEEL_SLOTS; uxSlot++ )
+        {
+            vListInitialise( &( xDelayedTaskWheel[ uxSlot ] ) );
+        }
+
+        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) ( configTIMING_WHEEL_SLOTS / 32U ); uxSlot++ )
+        {
+            ulDelayedTaskWheelSlotMap[ uxSlot ] = 0U;
+        }
+
+        vListInitialise( &xDelayedTaskWheelOverflow );
+    }
+    #endif /* configUSE_TIMING_WHEEL */
+
     #if ( INCLUDE_vTaskDelete == 1 )
     {
         vListInitialise( &xTasksWaitingTermination );
@@ -6514,25 +6667,249 @@ static void prvCheckTasksWaitingTermination( void )
 
 static void prvResetNextTaskUnblockTime( void )
 {
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+    #if ( configUSE_TIMING_WHEEL == 1 )
     {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
+        /* The slot for the current tick has already been processed, so the
+         * wheel is searched from the slot after it. */
+        xNextTaskUnblockTime = prvWheelNextUnblockTime( xTickCount );
     }
-    else
+    #else /* if ( configUSE_TIMING_WHEEL == 1 ) */
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
     }
+    #endif /* if ( configUSE_TIMING_WHEEL == 1 ) */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TIMING_WHEEL == 1 )
+
+    static void prvWheelInsert( ListItem_t * pxStateListItem,
+                                TickType_t xTimeToWake,
+                                TickType_t xConstTickCount )
+    {
+        TickType_t xEventTime;
+
+        /* The slot for the current tick has already been processed.  A zero
+         * length block is woken by the next tick, as it is when the delayed
+         * lists are used. */
+        if( xTimeToWake == xConstTickCount )
+        {
+            xTimeToWake++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listSET_LIST_ITEM_VALUE( pxStateListItem, xTimeToWake );
+
+        if( ( TickType_t ) ( xTimeToWake - xConstTickCount ) < ( TickType_t ) configTIMING_WHEEL_SLOTS )
+        {
+            traceMOVED_TASK_TO_DELAYED_LIST();
+            taskWHEEL_INSERT_IN_SLOT( pxStateListItem, xTimeToWake );
+            xEventTime = xTimeToWake;
+        }
+        else
+        {
+            /* Not due within this revolution of the wheel.  The overflow list
+             * only has to be scanned once the revolution in which its earliest
+             * task is due has started. */
+            xEventTime = taskWHEEL_REVOLUTION_START( xTimeToWake );
+
+            if( ( listLIST_IS_EMPTY( &xDelayedTaskWheelOverflow ) != pdFALSE ) ||
+                ( ( TickType_t ) ( xEventTime - xConstTickCount ) < ( TickType_t ) ( xDelayedTaskWheelCascadeTime - xConstTickCount ) ) )
+            {
+                xDelayedTaskWheelCascadeTime = xEventTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+            listINSERT_END( &xDelayedTaskWheelOverflow, pxStateListItem );
+        }
+
+        /* An event beyond the next tick count overflow is picked up when
+         * taskSWITCH_DELAYED_LISTS() rearms the wheel at tick 0. */
+        if( ( xEventTime >= xConstTickCount ) && ( xEventTime < xNextTaskUnblockTime ) )
+        {
+            xNextTaskUnblockTime = xEventTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWheelCascade( TickType_t xConstTickCount )
+    {
+        ListItem_t * pxListItem = listGET_HEAD_ENTRY( &xDelayedTaskWheelOverflow );
+        ListItem_t const * const pxListEnd = listGET_END_MARKER( &xDelayedTaskWheelOverflow );
+        ListItem_t * pxNextListItem;
+        TickType_t xTicksToWake;
+        TickType_t xEarliest = portMAX_DELAY;
+
+        /* Move every task now due within one revolution into its slot and
+         * note how far away the earliest of those left behind is.  Each task
+         * is visited at most once per revolution of the wheel. */
+        while( pxListItem != pxListEnd )
+        {
+            pxNextListItem = listGET_NEXT( pxListItem );
+            xTicksToWake = ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxListItem ) - xConstTickCount );
+
+            if( xTicksToWake < ( TickType_t ) configTIMING_WHEEL_SLOTS )
+            {
+                listREMOVE_ITEM( pxListItem );
+                taskWHEEL_INSERT_IN_SLOT( pxListItem, listGET_LIST_ITEM_VALUE( pxListItem ) );
+            }
+            else if( xTicksToWake < xEarliest )
+            {
+                xEarliest = xTicksToWake;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxListItem = pxNextListItem;
+        }
+
+        if( listLIST_IS_EMPTY( &xDelayedTaskWheelOverflow ) == pdFALSE )
+        {
+            xDelayedTaskWheelCascadeTime = taskWHEEL_REVOLUTION_START( xConstTickCount + xEarliest );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvWheelGetDueTask( TickType_t xConstTickCount )
+    {
+        List_t * const pxSlot = &( xDelayedTaskWheel[ xConstTickCount & taskWHEEL_SLOT_MASK ] );
+        TCB_t * pxTCB = NULL;
+
+        if( ( xConstTickCount == xDelayedTaskWheelCascadeTime ) && ( listLIST_IS_EMPTY( &xDelayedTaskWheelOverflow ) == pdFALSE ) )
+        {
+            prvWheelCascade( xConstTickCount );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Every task in the slot for the current tick is due now. */
+        if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+        {
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvWheelNextUnblockTime( TickType_t xConstTickCount )
+    {
+        TickType_t xTicksToEvent = portMAX_DELAY;
+        TickType_t xOffset;
+        TickType_t xNextUnblockTime;
+        UBaseType_t uxSlot;
+        uint32_t ulSlotBit;
+
+        /* Slots are emptied without clearing their bit when tasks leave the
+         * Blocked state for a reason other than a timeout, so the bit of any
+         * empty slot found on the way is cleared, starting with the slot for
+         * the current tick. */
+        for( xOffset = ( TickType_t ) 0U; xOffset < ( TickType_t ) configTIMING_WHEEL_SLOTS; xOffset++ )
+        {
+            uxSlot = ( UBaseType_t ) ( ( xConstTickCount + xOffset ) & taskWHEEL_SLOT_MASK );
+            ulSlotBit = ( uint32_t ) 1U << ( uxSlot & 31U );
+
+            if( ( ( uxSlot & 31U ) == 0U ) && ( ulDelayedTaskWheelSlotMap[ uxSlot >> 5 ] == 0U ) )
+            {
+                /* 32 empty slots - the loop increment skips the last. */
+                xOffset += ( TickType_t ) 31U;
+            }
+            else if( ( ulDelayedTaskWheelSlotMap[ uxSlot >> 5 ] & ulSlotBit ) == 0U )
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+            else if( ( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxSlot ] ) ) != pdFALSE ) || ( xOffset == ( TickType_t ) 0U ) )
+            {
+                /* The slot for the current tick is empty once it has been
+                 * processed, even if the check above cannot see it yet. */
+                ulDelayedTaskWheelSlotMap[ uxSlot >> 5 ] &= ~ulSlotBit;
+            }
+            else
+            {
+                xTicksToEvent = xOffset;
+                break;
+            }
+        }
+
+        if( listLIST_IS_EMPTY( &xDelayedTaskWheelOverflow ) == pdFALSE )
+        {
+            xOffset = ( TickType_t ) ( xDelayedTaskWheelCascadeTime - xConstTickCount );
+
+            if( xOffset < xTicksToEvent )
+            {
+                xTicksToEvent = xOffset;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xNextUnblockTime = xConstTickCount + xTicksToEvent;
+
+        if( ( xTicksToEvent == portMAX_DELAY ) || ( xNextUnblockTime < xConstTickCount ) )
+        {
+            /* Nothing is delayed, or the next event is beyond the tick count
+             * overflow, in which case taskSWITCH_DELAYED_LISTS() rearms the
+             * wheel when the tick count reaches 0. */
+            xNextUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNextUnblockTime;
+    }
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_RECURSIVE_MUTEXES == 1 ) ) || ( configNUMBER_OF_CORES > 1 )
 
     #if ( configNUMBER_OF_CORES == 1 )
@@ -8581,8 +8958,11 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 {
     TickType_t xTimeToWake;
     const TickType_t xConstTickCount = xTickCount;
-    List_t * const pxDelayedList = pxDelayedTaskList;
-    List_t * const pxOverflowDelayedList = pxOverflowDelayedTaskList;
+
+    #if ( configUSE_TIMING_WHEEL == 0 )
+        List_t * const pxDelayedList = pxDelayedTaskList;
+        List_t * const pxOverflowDelayedList = pxOverflowDelayedTaskList;
+    #endif
 
     #if ( INCLUDE_xTaskAbortDelay == 1 )
     {
@@ -8622,35 +9002,43 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
              * kernel will manage it correctly. */
             xTimeToWake = xConstTickCount + xTicksToWait;
 
-            /* The list item will be inserted in wake time order. */
-            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
-
-            if( xTimeToWake < xConstTickCount )
+            #if ( configUSE_TIMING_WHEEL == 1 )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
-                traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-                vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                prvWheelInsert( &( pxCurrentTCB->xStateListItem ), xTimeToWake, xConstTickCount );
             }
-            else
+            #else /* if ( configUSE_TIMING_WHEEL == 1 ) */
             {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
-                traceMOVED_TASK_TO_DELAYED_LIST();
-                vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+                /* The list item will be inserted in wake time order. */
+                listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
+                if( xTimeToWake < xConstTickCount )
                 {
-                    xNextTaskUnblockTime = xTimeToWake;
+                    /* Wake time has overflowed.  Place this item in the overflow
+                     * list. */
+                    traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                    vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The wake time has not overflowed, so the current block list
+                     * is used. */
+                    traceMOVED_TASK_TO_DELAYED_LIST();
+                    vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+
+                    /* If the task entering the blocked state was placed at the
+                     * head of the list of blocked tasks then xNextTaskUnblockTime
+                     * needs to be updated too. */
+                    if( xTimeToWake < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
+            #endif /* if ( configUSE_TIMING_WHEEL == 1 ) */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -8660,33 +9048,41 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
          * will manage it correctly. */
         xTimeToWake = xConstTickCount + xTicksToWait;
 
-        /* The list item will be inserted in wake time order. */
-        listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
-
-        if( xTimeToWake < xConstTickCount )
+        #if ( configUSE_TIMING_WHEEL == 1 )
         {
-            traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            prvWheelInsert( &( pxCurrentTCB->xStateListItem ), xTimeToWake, xConstTickCount );
         }
-        else
+        #else /* if ( configUSE_TIMING_WHEEL == 1 ) */
         {
-            traceMOVED_TASK_TO_DELAYED_LIST();
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+            /* The list item will be inserted in wake time order. */
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            if( xTimeToWake < xConstTickCount )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                /* Wake time has overflowed.  Place this item in the overflow list. */
+                vListInsert( pxOverflowDelayedList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                traceMOVED_TASK_TO_DELAYED_LIST();
+                /* The wake time has not overflowed, so the current block list is used. */
+                vListInsert( pxDelayedList, &( pxCurrentTCB->xStateListItem ) );
+
+                /* If the task entering the blocked state was placed at the head of the
+                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                 * too. */
+                if( xTimeToWake < xNextTaskUnblockTime )
+                {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* if ( configUSE_TIMING_WHEEL == 1 ) */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
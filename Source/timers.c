@@ -79,6 +79,14 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( 0x02U )
     #define tmrSTATUS_IS_AUTORELOAD              ( 0x04U )
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* The wheel slot that holds timers expiring at a given tick, and the first tick
+ * of the revolution of the wheel in which a given tick falls. */
+        #define tmrWHEEL_SLOT_MASK                     ( ( TickType_t ) configTIMER_WHEEL_SLOTS - ( TickType_t ) 1U )
+        #define tmrWHEEL_REVOLUTION_START( xTime )    ( ( xTime ) & ~tmrWHEEL_SLOT_MASK )
+    #endif
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                                               /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -145,6 +153,25 @@
     PRIVILEGED_DATA static List_t * pxCurrentTimerList;
     PRIVILEGED_DATA static List_t * pxOverflowTimerList;
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* When configUSE_TIMER_WHEEL is 1 active timers are held on a hashed timing
+ * wheel instead of the two sorted lists above, which then remain empty.  A
+ * timer expiring within configTIMER_WHEEL_SLOTS ticks of the cursor is appended
+ * to the slot selected by the low bits of its expiry time, so starting,
+ * stopping and expiring a timer no longer depend on the number of active
+ * timers.  Timers expiring further ahead wait, unsorted, on the overflow list
+ * until the revolution of the wheel in which they expire.  The cursor is the
+ * expiry time last processed, or the time at which the timer service task last
+ * found nothing due, so it never passes a timer that has not been processed. */
+        PRIVILEGED_DATA static List_t xActiveTimerWheel[ configTIMER_WHEEL_SLOTS ];
+        PRIVILEGED_DATA static List_t xActiveTimerWheelOverflow;
+        PRIVILEGED_DATA static uint32_t ulActiveTimerWheelSlotMap[ configTIMER_WHEEL_SLOTS / 32U ];
+        PRIVILEGED_DATA static TickType_t xActiveTimerWheelCursor = ( TickType_t ) 0U;
+        PRIVILEGED_DATA static TickType_t xActiveTimerWheelCascadeTime = ( TickType_t ) 0U;
+
+    #endif
+
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
@@ -219,9 +246,38 @@
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
+/*
+ * Timing wheel helpers.  prvTimerWheelInsert() places an active timer in the
+ * slot for its expiry time, or on the overflow list if it does not expire
+ * within one revolution of the wheel.  prvTimerWheelGetNextExpireTime() has
+ * the same contract as prvGetNextExpireTime(), the expiry times of timers
+ * beyond the next tick count overflow counting as the overflow list.
+ * prvTimerWheelGetExpired() moves the cursor to xNextExpireTime, cascading the
+ * overflow list into the wheel if its revolution has started, then returns a
+ * timer that expires at the cursor, or NULL if only the overflow list was due.
+ * prvTimerWheelIsEmpty() returns pdTRUE if no timers are active.
+ */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvTimerWheelInsert( Timer_t * const pxTimer,
+                                         const TickType_t xNextExpiryTime ) PRIVILEGED_FUNCTION;
+
+        static TickType_t prvTimerWheelGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+        static Timer_t * prvTimerWheelGetExpired( const TickType_t xNextExpireTime ) PRIVILEGED_FUNCTION;
+
+        static BaseType_t prvTimerWheelIsEmpty( void ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+/*
+ * Apply one command received on the timer queue.
+ */
+    static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
 /*
  * Called after a Timer_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -714,30 +770,44 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        /* MISRA Ref 11.5.3 [Void pointer assignment] */
-        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-        /* coverity[misra_c_2012_rule_11_5_violation] */
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+        #if ( configUSE_TIMER_WHEEL == 1 )
+            Timer_t * const pxTimer = prvTimerWheelGetExpired( xNextExpireTime );
+        #else
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+        #endif
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+        /* pxTimer is only NULL when the timing wheel's overflow list was due,
+         * in which case its timers have been moved into their slots and no
+         * callback is due yet. */
+        if( pxTimer != NULL )
+        {
+            /* Remove the timer from the list of active timers.  A check has already
+             * been performed to ensure the list is not empty. */
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
-        {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            /* If the timer is an auto-reload timer then calculate the next
+             * expiry time and re-insert the timer in the list of active timers. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+            {
+                prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            }
+
+            /* Call the timer callback. */
+            traceTIMER_EXPIRED( pxTimer );
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
         }
         else
         {
-            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            mtCOVERAGE_TEST_MARKER();
         }
-
-        /* Call the timer callback. */
-        traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
     }
 /*-----------------------------------------------------------*/
 
@@ -775,7 +845,7 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty )
     {
         TickType_t xTimeNow;
@@ -797,6 +867,36 @@
                 {
                     ( void ) xTaskResumeAll();
                     prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+                    #if ( configTIMER_BATCH_SIZE > 1 )
+                    {
+                        UBaseType_t uxProcessed;
+
+                        /* Process other timers that have already expired
+                         * without going back round the daemon loop, which
+                         * would suspend the scheduler for each of them.  Stop
+                         * as soon as a command is waiting, so a callback that
+                         * stops or changes another expired timer still
+                         * prevents that timer's callback, as it would without
+                         * batching. */
+                        for( uxProcessed = ( UBaseType_t ) 1U; uxProcessed < ( UBaseType_t ) configTIMER_BATCH_SIZE; uxProcessed++ )
+                        {
+                            if( uxQueueMessagesWaiting( xTimerQueue ) != ( UBaseType_t ) 0U )
+                            {
+                                break;
+                            }
+
+                            xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+
+                            if( ( xListWasEmpty != pdFALSE ) || ( xNextExpireTime > xTimeNow ) )
+                            {
+                                break;
+                            }
+
+                            prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                        }
+                    }
+                    #endif /* configTIMER_BATCH_SIZE */
                 }
                 else
                 {
@@ -810,8 +910,23 @@
                     {
                         /* The current timer list is empty - is the overflow list
                          * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        #if ( configUSE_TIMER_WHEEL == 1 )
+                            xListWasEmpty = prvTimerWheelIsEmpty();
+                        #else
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        #endif
+                    }
+
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        /* No timer expires before xTimeNow, so the cursor can
+                         * move up to it.  This keeps the distance from the
+                         * cursor to the expiry time of any timer below the
+                         * tick count range as long as timer periods are less
+                         * than half of it. */
+                        xActiveTimerWheelCursor = xTimeNow;
                     }
+                    #endif
 
                     vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
@@ -841,24 +956,32 @@
     {
         TickType_t xNextExpireTime;
 
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            xNextExpireTime = prvTimerWheelGetNextExpireTime( pxListWasEmpty );
         }
-        else
+        #else
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xNextExpireTime;
     }
@@ -909,7 +1032,11 @@
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvTimerWheelInsert( pxTimer, xNextExpiryTime );
+                #else
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                #endif
             }
         }
         else
@@ -923,7 +1050,11 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvTimerWheelInsert( pxTimer, xNextExpiryTime );
+                #else
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #endif
             }
         }
 
@@ -933,155 +1064,175 @@
 
     static void prvProcessReceivedCommands( void )
     {
-        DaemonTaskMessage_t xMessage = { 0 };
+        /* Only the timer service task uses the batch, so it is kept off the
+         * task's stack. */
+        PRIVILEGED_DATA static DaemonTaskMessage_t xMessages[ configTIMER_BATCH_SIZE ];
+        UBaseType_t uxReceived;
+        UBaseType_t uxMessage;
+
+        do
+        {
+            /* Take up to configTIMER_BATCH_SIZE commands off the queue in one
+             * go before applying any of them.  The time is sampled for each
+             * command as it is applied, so it can still not be earlier than the
+             * time at which the command was sent. */
+            uxReceived = ( UBaseType_t ) xQueueReceiveMultiple( xTimerQueue, xMessages, ( UBaseType_t ) configTIMER_BATCH_SIZE, tmrNO_DELAY );
+
+            for( uxMessage = ( UBaseType_t ) 0U; uxMessage < uxReceived; uxMessage++ )
+            {
+                prvProcessCommand( &( xMessages[ uxMessage ] ) );
+            }
+        } while( uxReceived == ( UBaseType_t ) configTIMER_BATCH_SIZE );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage )
+    {
         Timer_t * pxTimer;
         BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL )
+        #if ( INCLUDE_xTimerPendFunctionCall == 1 )
         {
-            #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+            /* Negative commands are pended function calls rather than timer
+             * commands. */
+            if( pxMessage->xMessageID < ( BaseType_t ) 0 )
             {
-                /* Negative commands are pended function calls rather than timer
-                 * commands. */
-                if( xMessage.xMessageID < ( BaseType_t ) 0 )
-                {
-                    const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
+                const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
+
+                /* The timer uses the xCallbackParameters member to request a
+                 * callback be executed.  Check the callback is not NULL. */
+                configASSERT( pxCallback );
+
+                /* Call the function. */
+                pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* INCLUDE_xTimerPendFunctionCall */
 
-                    /* The timer uses the xCallbackParameters member to request a
-                     * callback be executed.  Check the callback is not NULL. */
-                    configASSERT( pxCallback );
+        /* Commands that are positive are timer commands rather than pended
+         * function calls. */
+        if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+        {
+            /* The messages uses the xTimerParameters member to work on a
+             * software timer. */
+            pxTimer = pxMessage->u.xTimerParameters.pxTimer;
 
-                    /* Call the function. */
-                    pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+            if( pxTimer != NULL )
+            {
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+                {
+                    /* The timer is in a list, remove it. */
+                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-            }
-            #endif /* INCLUDE_xTimerPendFunctionCall */
-
-            /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
-            {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
-
-                if( pxTimer != NULL )
-                {
-                    if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
-                    {
-                        /* The timer is in a list, remove it. */
-                        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
 
-                    traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+                traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
 
-                    /* In this case the xTimerListsWereSwitched parameter is not used, but
-                     *  it must be present in the function call.  prvSampleTimeNow() must be
-                     *  called after the message is received from xTimerQueue so there is no
-                     *  possibility of a higher priority task adding a message to the message
-                     *  queue with a time that is ahead of the timer daemon task (because it
-                     *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                    xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+                /* In this case the xTimerListsWereSwitched parameter is not used, but
+                 *  it must be present in the function call.  prvSampleTimeNow() must be
+                 *  called after the message is received from xTimerQueue so there is no
+                 *  possibility of a higher priority task adding a message to the message
+                 *  queue with a time that is ahead of the timer daemon task (because it
+                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
+                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
 
-                    switch( xMessage.xMessageID )
-                    {
-                        case tmrCOMMAND_START:
-                        case tmrCOMMAND_START_FROM_ISR:
-                        case tmrCOMMAND_RESET:
-                        case tmrCOMMAND_RESET_FROM_ISR:
-                            /* Start or restart a timer. */
-                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-
-                            if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+                switch( pxMessage->xMessageID )
+                {
+                    case tmrCOMMAND_START:
+                    case tmrCOMMAND_START_FROM_ISR:
+                    case tmrCOMMAND_RESET:
+                    case tmrCOMMAND_RESET_FROM_ISR:
+                        /* Start or restart a timer. */
+                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+
+                        if( prvInsertTimerInActiveList( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue ) != pdFALSE )
+                        {
+                            /* The timer expired before it was added to the active
+                             * timer list.  Process it now. */
+                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
                             {
-                                /* The timer expired before it was added to the active
-                                 * timer list.  Process it now. */
-                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
-                                {
-                                    prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                                }
-                                else
-                                {
-                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                                }
-
-                                /* Call the timer callback. */
-                                traceTIMER_EXPIRED( pxTimer );
-                                pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                                prvReloadTimer( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
                             }
                             else
                             {
-                                mtCOVERAGE_TEST_MARKER();
+                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
                             }
 
-                            break;
-
-                        case tmrCOMMAND_STOP:
-                        case tmrCOMMAND_STOP_FROM_ISR:
-                            /* The timer has already been removed from the active list. */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            break;
-
-                        case tmrCOMMAND_CHANGE_PERIOD:
-                        case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                            pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
-                            pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                            configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                            /* The new period does not really have a reference, and can
-                             * be longer or shorter than the old one.  The command time is
-                             * therefore set to the current time, and as the period cannot
-                             * be zero the next expiry time can only be in the future,
-                             * meaning (unlike for the xTimerStart() case above) there is
-                             * no fail case that needs to be handled here. */
-                            ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                            break;
-
-                        case tmrCOMMAND_DELETE:
-                            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                            /* Call the timer callback. */
+                            traceTIMER_EXPIRED( pxTimer );
+                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        break;
+
+                    case tmrCOMMAND_STOP:
+                    case tmrCOMMAND_STOP_FROM_ISR:
+                        /* The timer has already been removed from the active list. */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        break;
+
+                    case tmrCOMMAND_CHANGE_PERIOD:
+                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                        pxTimer->ucStatus |= ( uint8_t ) tmrSTATUS_IS_ACTIVE;
+                        pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                        /* The new period does not really have a reference, and can
+                         * be longer or shorter than the old one.  The command time is
+                         * therefore set to the current time, and as the period cannot
+                         * be zero the next expiry time can only be in the future,
+                         * meaning (unlike for the xTimerStart() case above) there is
+                         * no fail case that needs to be handled here. */
+                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                        break;
+
+                    case tmrCOMMAND_DELETE:
+                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                        {
+                            /* The timer has already been removed from the active list,
+                             * just free up the memory if the memory was dynamically
+                             * allocated. */
+                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
                             {
-                                /* The timer has already been removed from the active list,
-                                 * just free up the memory if the memory was dynamically
-                                 * allocated. */
-                                if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                                {
-                                    vPortFree( pxTimer );
-                                }
-                                else
-                                {
-                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                                }
+                                vPortFree( pxTimer );
                             }
-                            #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                            else
                             {
-                                /* If dynamic allocation is not enabled, the memory
-                                 * could not have been dynamically allocated. So there is
-                                 * no need to free the memory - just mark the timer as
-                                 * "not active". */
                                 pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
                             }
-                            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                            break;
+                        }
+                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                        {
+                            /* If dynamic allocation is not enabled, the memory
+                             * could not have been dynamically allocated. So there is
+                             * no need to free the memory - just mark the timer as
+                             * "not active". */
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                        break;
 
-                        default:
-                            /* Don't expect to get here. */
-                            break;
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+                    default:
+                        /* Don't expect to get here. */
+                        break;
                 }
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
     }
 /*-----------------------------------------------------------*/
@@ -1089,28 +1240,269 @@
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
-        List_t * pxTemp;
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            BaseType_t xNoneBeforeOverflow;
+
+            /* The tick count has overflowed.  Process every timer that expired
+             * before the overflow, in the same way as the timers left in the
+             * current list are processed below, then restart the cursor from
+             * tick 0 so expiry times after the overflow compare correctly with
+             * it.  Nothing expiring after the overflow has been processed, so
+             * the cursor does not pass any timers. */
+            for( ; ; )
+            {
+                xNextExpireTime = prvTimerWheelGetNextExpireTime( &xNoneBeforeOverflow );
+
+                if( xNoneBeforeOverflow != pdFALSE )
+                {
+                    break;
+                }
+
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            xActiveTimerWheelCursor = ( TickType_t ) 0U;
         }
+        #else /* if ( configUSE_TIMER_WHEEL == 1 ) */
+        {
+            List_t * pxTemp;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
+        }
+        #endif /* if ( configUSE_TIMER_WHEEL == 1 ) */
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvTimerWheelInsert( Timer_t * const pxTimer,
+                                         const TickType_t xNextExpiryTime )
+        {
+            UBaseType_t uxSlot;
+            TickType_t xRevolutionStart;
+
+            /* The expiry time is after the time now, and the cursor is not
+             * after the time now, so the distance is at least one tick. */
+            if( ( TickType_t ) ( xNextExpiryTime - xActiveTimerWheelCursor ) < ( TickType_t ) configTIMER_WHEEL_SLOTS )
+            {
+                uxSlot = ( UBaseType_t ) ( xNextExpiryTime & tmrWHEEL_SLOT_MASK );
+                listINSERT_END( &( xActiveTimerWheel[ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+                ulActiveTimerWheelSlotMap[ uxSlot >> 5 ] |= ( uint32_t ) 1U << ( uxSlot & 31U );
+            }
+            else
+            {
+                /* The overflow list is only scanned once the revolution in
+                 * which its earliest timer expires has started. */
+                xRevolutionStart = tmrWHEEL_REVOLUTION_START( xNextExpiryTime );
+
+                if( ( listLIST_IS_EMPTY( &xActiveTimerWheelOverflow ) != pdFALSE ) ||
+                    ( ( TickType_t ) ( xRevolutionStart - xActiveTimerWheelCursor ) < ( TickType_t ) ( xActiveTimerWheelCascadeTime - xActiveTimerWheelCursor ) ) )
+                {
+                    xActiveTimerWheelCascadeTime = xRevolutionStart;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                listINSERT_END( &xActiveTimerWheelOverflow, &( pxTimer->xTimerListItem ) );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvTimerWheelGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+        {
+            TickType_t xTicksToExpiry = ( TickType_t ) 0U;
+            TickType_t xOffset;
+            TickType_t xNextExpireTime;
+            BaseType_t xFound = pdFALSE;
+            UBaseType_t uxSlot;
+            uint32_t ulSlotBit;
+
+            /* Find the first occupied slot, starting with the slot for the
+             * cursor as it may still hold timers that are due.  Slots are
+             * emptied without clearing their bit when timers are stopped, so
+             * the bit of any empty slot found on the way is cleared. */
+            for( xOffset = ( TickType_t ) 0U; xOffset < ( TickType_t ) configTIMER_WHEEL_SLOTS; xOffset++ )
+            {
+                uxSlot = ( UBaseType_t ) ( ( xActiveTimerWheelCursor + xOffset ) & tmrWHEEL_SLOT_MASK );
+                ulSlotBit = ( uint32_t ) 1U << ( uxSlot & 31U );
+
+                if( ( ( uxSlot & 31U ) == 0U ) && ( ulActiveTimerWheelSlotMap[ uxSlot >> 5 ] == 0U ) )
+                {
+                    /* 32 empty slots - the loop increment skips the last. */
+                    xOffset += ( TickType_t ) 31U;
+                }
+                else if( ( ulActiveTimerWheelSlotMap[ uxSlot >> 5 ] & ulSlotBit ) == 0U )
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                else if( listLIST_IS_EMPTY( &( xActiveTimerWheel[ uxSlot ] ) ) != pdFALSE )
+                {
+                    ulActiveTimerWheelSlotMap[ uxSlot >> 5 ] &= ~ulSlotBit;
+                }
+                else
+                {
+                    xTicksToExpiry = xOffset;
+                    xFound = pdTRUE;
+                    break;
+                }
+            }
+
+            if( listLIST_IS_EMPTY( &xActiveTimerWheelOverflow ) == pdFALSE )
+            {
+                xOffset = ( TickType_t ) ( xActiveTimerWheelCascadeTime - xActiveTimerWheelCursor );
+
+                if( ( xFound == pdFALSE ) || ( xOffset < xTicksToExpiry ) )
+                {
+                    xTicksToExpiry = xOffset;
+                    xFound = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xNextExpireTime = xActiveTimerWheelCursor + xTicksToExpiry;
+
+            if( ( xFound == pdFALSE ) || ( xNextExpireTime < xActiveTimerWheelCursor ) )
+            {
+                /* Nothing expires before the tick count overflows.  As for the
+                 * sorted lists, return 0 so the timer service task unblocks
+                 * when the tick count overflows. */
+                *pxListWasEmpty = pdTRUE;
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+            else
+            {
+                *pxListWasEmpty = pdFALSE;
+            }
+
+            return xNextExpireTime;
+        }
+/*-----------------------------------------------------------*/
+
+        static Timer_t * prvTimerWheelGetExpired( const TickType_t xNextExpireTime )
+        {
+            List_t * const pxSlot = &( xActiveTimerWheel[ xNextExpireTime & tmrWHEEL_SLOT_MASK ] );
+            ListItem_t * pxListItem;
+            ListItem_t * pxNextListItem;
+            ListItem_t const * pxListEnd;
+            TickType_t xTicksToExpiry;
+            TickType_t xEarliest = portMAX_DELAY;
+            Timer_t * pxTimer = NULL;
+
+            xActiveTimerWheelCursor = xNextExpireTime;
+
+            if( ( xActiveTimerWheelCursor == xActiveTimerWheelCascadeTime ) && ( listLIST_IS_EMPTY( &xActiveTimerWheelOverflow ) == pdFALSE ) )
+            {
+                /* Move every timer now expiring within one revolution into its
+                 * slot and note how far away the earliest of those left behind
+                 * is.  Each timer is visited at most once per revolution. */
+                pxListItem = listGET_HEAD_ENTRY( &xActiveTimerWheelOverflow );
+                pxListEnd = listGET_END_MARKER( &xActiveTimerWheelOverflow );
+
+                while( pxListItem != pxListEnd )
+                {
+                    pxNextListItem = listGET_NEXT( pxListItem );
+                    xTicksToExpiry = ( TickType_t ) ( listGET_LIST_ITEM_VALUE( pxListItem ) - xActiveTimerWheelCursor );
+
+                    if( xTicksToExpiry < ( TickType_t ) configTIMER_WHEEL_SLOTS )
+                    {
+                        listREMOVE_ITEM( pxListItem );
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        prvTimerWheelInsert( ( Timer_t * ) listGET_LIST_ITEM_OWNER( pxListItem ), listGET_LIST_ITEM_VALUE( pxListItem ) );
+                    }
+                    else if( xTicksToExpiry < xEarliest )
+                    {
+                        xEarliest = xTicksToExpiry;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxListItem = pxNextListItem;
+                }
+
+                if( listLIST_IS_EMPTY( &xActiveTimerWheelOverflow ) == pdFALSE )
+                {
+                    xActiveTimerWheelCascadeTime = tmrWHEEL_REVOLUTION_START( xActiveTimerWheelCursor + xEarliest );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+            {
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxTimer;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvTimerWheelIsEmpty( void )
+        {
+            BaseType_t xIsEmpty = listLIST_IS_EMPTY( &xActiveTimerWheelOverflow );
+            UBaseType_t uxSlot;
+
+            for( uxSlot = ( UBaseType_t ) 0U; ( uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS ) && ( xIsEmpty != pdFALSE ); uxSlot++ )
+            {
+                if( ( ulActiveTimerWheelSlotMap[ uxSlot >> 5 ] & ( ( uint32_t ) 1U << ( uxSlot & 31U ) ) ) != 0U )
+                {
+                    xIsEmpty = listLIST_IS_EMPTY( &( xActiveTimerWheel[ uxSlot ] ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            return xIsEmpty;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
     static void prvCheckForValidListAndQueue( void )
     {
         /* Check that the list from which active timers are referenced, and the
@@ -1125,6 +1517,19 @@
                 pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
 
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxSlot;
+
+                    for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+                    {
+                        vListInitialise( &( xActiveTimerWheel[ uxSlot ] ) );
+                    }
+
+                    vListInitialise( &xActiveTimerWheelOverflow );
+                }
+                #endif /* configUSE_TIMER_WHEEL */
+
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
                     /* The timer queue is allocated statically in case
@@ -25,7 +25,8 @@
 
 #include <stdarg.h>
 #include <string.h>
-#include "debug.h"
+#include "debug.h"
+#include "ustdlib.h"
 
 //*****************************************************************************
 //
@@ -30,6 +30,8 @@ static void Default_Handler(void)
 void Timer0IntHandler(void) __attribute__ ((weak, alias("Default_Handler")));
 void vT2InterruptHandler(void) __attribute__ ((weak, alias("Default_Handler")));
 void vT3InterruptHandler(void) __attribute__ ((weak, alias("Default_Handler")));
+void OSRAM128x64x4IntHandler(void) __attribute__ ((weak, alias("Default_Handler")));
+void UART0IntHandler(void) __attribute__ ((weak, alias("Default_Handler")));
 
 /*
  * startup.c 中的 IntDefaultHandler 也是一个无限循环。
@@ -14,129 +14,224 @@
 #include "uart.h"
 #include "grlib.h"
 #include "osram128x64x4.h"
-
-/* OLED setup constants */
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
-#define BLOCK_SIZE 2          // 一个蛇节占 4x4 像素
-#define MAX_SNAKE_LENGTH 256
-
-/* 按键定义：假设用 UART 字母输入控制 */
-#define KEY_UP    'w'
-#define KEY_DOWN  's'
-#define KEY_LEFT  'a'
-#define KEY_RIGHT 'd'
-#define KEY_R     'r'
-
-/* 数据结构 */
-typedef struct {
-    int x;
-    int y;
-} Point;
-
-typedef enum {
-    DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT, R
-} Direction;
-
-typedef struct {
-    Direction dir;
-} KeyMsg;
-
-// --- 共享的游戏状态结构体 ---
-typedef struct {
-    Point snake[MAX_SNAKE_LENGTH];
-    int snakeLength;
-    Point food;
-    tBoolean gameOver;
-} GameState_t;
-
+#include "snake.h"
+#include "gameclock.h"
+#include "input.h"
+#include "latency.h"
+#include "timestamp.h"
+#include "uartprint.h"
+#include "lowpower.h"
+
+/* 置1时运行板上性能测试（见 LocalDemoFiles/benchmark.c）而不是游戏，
+   用 cmake -DSNAKE_BENCHMARKS=ON 打开 */
+#ifndef mainRUN_BENCHMARKS
+#define mainRUN_BENCHMARKS 0
+#endif
+
+#if mainRUN_BENCHMARKS
+#include "benchmark.h"
+#endif
+
+/* 置1时运行栈使用监视任务（见 LocalDemoFiles/stackmon.c），每局结束时输出各任务的栈使用和建议大小，
+   用 cmake -DSNAKE_STACK_ANALYSIS=ON 打开 */
+#ifndef mainSTACK_MONITOR
+#define mainSTACK_MONITOR 0
+#endif
+
+#if mainSTACK_MONITOR
+#include "stackmon.h"
+#endif
+
+/* 置1时重新开始游戏走原来的路径：蛇任务动态创建一个新的蛇任务后删除自己，
+   新任务初始化游戏状态后输出重启延迟，作为原地重启的对照。
+   用 cmake -DSNAKE_RESTART_BASELINE=ON 打开，需要堆 */
+#ifndef mainRESTART_BASELINE
+#define mainRESTART_BASELINE 0
+#endif
+
+#if mainRESTART_BASELINE && !configSUPPORT_DYNAMIC_ALLOCATION
+#error "mainRESTART_BASELINE creates the snake task on the heap"
+#endif
+
+#if mainRESTART_BASELINE && mainSTACK_MONITOR
+#error "mainRESTART_BASELINE deletes the snake task the stack monitor watches"
+#endif
+
+/* 游戏节拍：周期（微秒）和错过节拍时的追赶策略，见 LocalDemoFiles/gameclock.h */
+#define GAME_TICK_PERIOD_US 150000UL
+#define GAME_CATCH_UP       eGameClockSkip
+#define GAME_MAX_CATCH_UP   2
 
 #define KEY_QUEUE_LENGTH 5
 #define KEY_QUEUE_ITEM_SIZE sizeof(KeyMsg)
 
 QueueHandle_t xKeyQueue;
-// --- 用于保护游戏状态的互斥锁 ---
-SemaphoreHandle_t xGameStateMutex;
+static StaticQueue_t s_keyQueueStruct;
+static uint8_t s_keyQueueStorage[KEY_QUEUE_LENGTH * KEY_QUEUE_ITEM_SIZE];
 
-void vRestart(void *pvParameters);
+void vSnakeTask(void *pvParameters);
 void vDrawTask(void *pvParameters); 
 
+/* --- 任务只在启动时静态创建一次，之后一直存在 ---
+   重新开始游戏不创建/删除任务，不用堆，也不需要按名字查找任务句柄 */
+#define SNAKE_TASK_STACK_SIZE (configMINIMAL_STACK_SIZE * 2)
+#define DRAW_TASK_STACK_SIZE  (configMINIMAL_STACK_SIZE * 3)
+
+static StaticTask_t s_snakeTaskTCB;
+static StackType_t s_snakeTaskStack[SNAKE_TASK_STACK_SIZE];
+static StaticTask_t s_drawTaskTCB;
+static StackType_t s_drawTaskStack[DRAW_TASK_STACK_SIZE];
+
+/* --- 游戏阶段：由蛇任务切换，绘图任务据此决定画什么 --- */
+typedef enum {
+    GAME_PLAYING,       // 正在游戏
+    GAME_OVER,          // 显示 GAME OVER（或 YOU WIN）一段时间
+    GAME_WAIT_RESTART   // 显示重启提示，等待 R 键
+} GamePhase;
+
 /* --- 将游戏状态变量放入一个全局静态结构体中 --- */
 static GameState_t s_gameState;
 static Direction s_currentDir = DIR_RIGHT;
+static volatile GamePhase s_phase = GAME_PLAYING; // 与 s_gameState 一起由顺序锁保护
+
+/* --- 游戏状态的无锁发布（顺序锁） ---
+   vSnakeTask 是唯一的写者，修改 s_gameState 前后各把序号加1，奇数表示正在写。
+   绘图任务读之前和读之后各取一次序号，两次相同且为偶数才说明读到的是一致的状态，
+   否则丢弃这次读取，下一帧再读。写者从不等待读者，读者也不会阻塞游戏节拍。
+   只有一个写者且是单核，所以不需要 LDREX/STREX，只需要内存屏障保证顺序。 */
+static volatile uint32_t s_stateSeq = 0;
+
+#define prvMemoryBarrier() __asm volatile ("dmb" ::: "memory")
 
 
 /* OLED 函数指针 */
 static void (*vOLEDInit)(uint32_t) = OSRAM128x64x4Init;
-static void (*vOLEDClear)(void) = OSRAM128x64x4Clear;
-// 假设有一个画实心矩形的函数，如果没有，需要自己实现或使用库函数
-static void (*vOLEDBlockDraw)(int x, int y, int w, int h) = DefaultBlockDraw;
-void ( * vOLEDStringDraw )( const char *,
-                                uint32_t,
-                                uint32_t,
-                                unsigned char ) = OSRAM128x64x4StringDraw;
+
+/* 帧缓冲绘图函数：先画到RAM中，再由 vOLEDFlush 只发送改变过的区域 */
+static void (*vOLEDFrameClear)(void) = OSRAM128x64x4FrameClear;
+static void (*vOLEDBlockDraw)(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
+                              unsigned char level) = OSRAM128x64x4FrameRectFill;
+static void (*vOLEDFrameStringDraw)(const char *, uint32_t, uint32_t,
+                                    unsigned char) = OSRAM128x64x4FrameStringDraw;
+static void (*vOLEDFlush)(void) = OSRAM128x64x4Flush;
 
 static void prvPrintString( const char * pcString );
 
 /*-----------------------------------------------------------*/
-/* 工具函数：随机生成食物 */
-void spawnFood() {
-    // 注意：此函数应该在获取互斥锁后调用
-    s_gameState.food.x = (rand() % (SCREEN_WIDTH / BLOCK_SIZE)) * BLOCK_SIZE;
-    s_gameState.food.y = (rand() % (SCREEN_HEIGHT / BLOCK_SIZE)) * BLOCK_SIZE;
+/* 顺序锁：写者 */
+static void prvStateWriteBegin(void) {
+    s_stateSeq++;
+    prvMemoryBarrier();
+}
+
+static void prvStateWriteEnd(void) {
+    prvMemoryBarrier();
+    s_stateSeq++;
+}
+
+/* 顺序锁：读者。prvStateReadRetry 返回 true 表示读到的数据可能不一致 */
+static uint32_t prvStateReadBegin(void) {
+    uint32_t seq = s_stateSeq;
+    prvMemoryBarrier();
+    return seq;
+}
+
+static tBoolean prvStateReadRetry(uint32_t seq) {
+    prvMemoryBarrier();
+    return (seq & 1) != 0 || s_stateSeq != seq;
 }
 
 /*-----------------------------------------------------------*/
-/* 键盘控制任务 */
-void vKeyboardTask(void *pvParameters) {
-    KeyMsg msg;
-    char c;
-    while(1) {
-        if (UARTCharsAvail(UART0_BASE)) {
-            c = UARTCharGetNonBlocking(UART0_BASE);
-            switch(c) {
-                case KEY_UP:    msg.dir = DIR_UP; break;
-                case KEY_DOWN:  msg.dir = DIR_DOWN; break;
-                case KEY_LEFT:  msg.dir = DIR_LEFT; break;
-                case KEY_RIGHT: msg.dir = DIR_RIGHT; break;
-                case KEY_R:     msg.dir = R; break;
-                default:        continue; // 非方向键忽略
-            }
-            xQueueSend(xKeyQueue, &msg, 0); // 发送方向消息
+/* --- 游戏绘图任务 --- */
+/* 绘制一个格子：游戏里都是格子坐标，只在这里换算成像素 */
+static void prvDrawCell(Point cell, unsigned char level) {
+    vOLEDBlockDraw(cell.x * BLOCK_SIZE, cell.y * BLOCK_SIZE, BLOCK_SIZE, BLOCK_SIZE, level);
+}
+
+/* 整屏重绘：只在重新开始、游戏结束或错过了某一拍的变化时使用 */
+static void prvDrawFullFrame(const GameState_t *pxState) {
+    vOLEDFrameClear(); // 清空帧缓冲（只标记原本有内容的区域）
+
+    if (!pxState->gameOver) {
+        // 绘制蛇
+        SnakeIter_t iter;
+        Point cell;
+        vSnakeIterInit(&iter, &pxState->body);
+        while (xSnakeIterNext(&iter, &cell)) {
+            prvDrawCell(cell, 0x0F);
         }
-        vTaskDelay(pdMS_TO_TICKS(30));
+        // 绘制食物
+        prvDrawCell(pxState->food, 0x0F);
+    } else if (pxState->won) {
+        // 蛇占满了整个棋盘
+        vOLEDFrameStringDraw("YOU WIN", 36, 30, 0x0F);
+    } else {
+        // 游戏结束
+        // prvPrintString("GAME OVER\n");
+        vOLEDFrameStringDraw("GAME OVER", 30, 30, 0x0F);
     }
 }
 
+/* 增量绘制：只应用最近一拍改变的格子 */
+static void prvApplyChanges(const TickChanges_t *pxChanges) {
+    for (int i = 0; i < pxChanges->count; i++) {
+        prvDrawCell(pxChanges->cells[i].cell, pxChanges->cells[i].set ? 0x0F : 0x00);
+    }
+}
 
-/*-----------------------------------------------------------*/
-/* --- 游戏绘图任务 --- */
 void vDrawTask(void *pvParameters) {
     (void)pvParameters;
-    GameState_t localGameState; // 创建一个本地副本以减少锁的持有时间
+    TickChanges_t localChanges;
+    uint32_t lastTick = 0;
+    uint32_t seq;
+    GamePhase phase;
+    tBoolean needFullRedraw = true; // 第一帧，或上次整屏重绘时读到了不一致的状态
+    tBoolean promptShown = false;   // 重启提示已经画出
 
     vOLEDInit(3500000); // 初始化OLED
 
     for(;;) {
-        // 获取互斥锁，拷贝共享状态到本地
-        if (xSemaphoreTake(xGameStateMutex, portMAX_DELAY) == pdTRUE) {
-            localGameState = s_gameState; // 结构体赋值是安全的
-            xSemaphoreGive(xGameStateMutex);
-        }
-
-        vOLEDClear(); // 清屏
+        // 无锁读取：通常只拷贝最近一拍的变化。
+        // 如果蛇任务正在更新或刚刚更新过，这次读取作废，下一帧再读
+        seq = prvStateReadBegin();
+        phase = s_phase;
+        localChanges = s_gameState.changes;
+
+        if (prvStateReadRetry(seq)) {
+            // 读到的状态不一致，下一帧再读
+        } else if (phase == GAME_WAIT_RESTART) {
+            // 等待重启：只画一次提示，开始新的一局时整屏重绘
+            if (!promptShown) {
+                vOLEDFrameClear();
+                vOLEDFrameStringDraw("PRESS KEY \"R\"", 4, 20, 0x0F);
+                vOLEDFrameStringDraw("TO RESTART", 4, 40, 0x0F);
+                vOLEDFlush();
+                promptShown = true;
+                needFullRedraw = true;
+            }
+        } else if (needFullRedraw || localChanges.tick != lastTick) {
+            promptShown = false;
+            vLatencyFramePicked(localChanges.tick); // 读到一致的快照时记录，包含到这一拍为止应用的转向
+            if (needFullRedraw || localChanges.resync ||
+                localChanges.tick != lastTick + 1) {
+                // 错过了某一拍或需要整屏重绘：直接从共享状态绘制，不拷贝。
+                // 绘制期间如果被蛇任务打断，画面可能不一致，下一帧重画
+                prvDrawFullFrame(&s_gameState);
+                needFullRedraw = prvStateReadRetry(seq);
+            } else {
+                prvApplyChanges(&localChanges);
+            }
 
-        if (!localGameState.gameOver) {
-            // 绘制蛇
-            for(int i = 0; i < localGameState.snakeLength; i++) {
-                vOLEDBlockDraw(localGameState.snake[i].x, localGameState.snake[i].y, BLOCK_SIZE, BLOCK_SIZE);
+            if (!needFullRedraw) {
+                lastTick = localChanges.tick;
+                vOLEDFlush(); // 只把与上一帧不同的区域发送到OLED
+                vLatencyFrameFlushed();        // SSI 传输已经结束，像素已经到达屏幕
             }
-            // 绘制食物
-            vOLEDBlockDraw(localGameState.food.x, localGameState.food.y, BLOCK_SIZE, BLOCK_SIZE);
-        } else {
-            // 游戏结束
-            // prvPrintString("GAME OVER\n");
-            vOLEDStringDraw("GAME OVER", 30, 30, 0x0F);
+        }
+
+        // 串口收到 '?' 时输出按键到屏幕的延迟统计
+        if (xInputStatsRequested()) {
+            vLatencyStatsPrint();
         }
 
         vTaskDelay(pdMS_TO_TICKS(50)); // 绘图任务不需要太高的刷新率
@@ -145,128 +240,121 @@ void vDrawTask(void *pvParameters) {
 
 /*-----------------------------------------------------------*/
 /* --- 游戏主逻辑任务 --- */
-void vSnakeTask(void *pvParameters) {
-    // 初始化游戏状态
-    if (xSemaphoreTake(xGameStateMutex, portMAX_DELAY) == pdTRUE) {
-        s_gameState.snakeLength = 3;    // 初始长度
-        s_currentDir = DIR_RIGHT;
-        s_gameState.gameOver = false;
-
-        spawnFood();
-
-        // 将初始Y坐标对齐到网格
-        int initial_y = (SCREEN_HEIGHT / 2 / BLOCK_SIZE) * BLOCK_SIZE; // 计算一个居中的、对齐的Y坐标
+/* 切换游戏阶段，和游戏状态一样通过顺序锁发布给绘图任务 */
+static void prvSetPhase(GamePhase phase) {
+    prvStateWriteBegin();
+    s_phase = phase;
+    prvStateWriteEnd();
+}
 
-        for (int i = 0; i < s_gameState.snakeLength; i++) {
-            s_gameState.snake[i].x = (s_gameState.snakeLength - i) * BLOCK_SIZE;
-            s_gameState.snake[i].y = initial_y; // 使用对齐后的Y坐标
-        }
-        xSemaphoreGive(xGameStateMutex);
-    }
+/* 初始化新的一局，并切换到游戏阶段 */
+static void prvNewGame(void) {
+    prvStateWriteBegin();
+    s_currentDir = DIR_RIGHT;
+    vSnakeGameSeed(&s_gameState, xTaskGetTickCount() ^ s_gameState.random); // 每局按开始的时刻换种子
+    vSnakeGameInit(&s_gameState);
+    s_phase = GAME_PLAYING;
+    prvStateWriteEnd();
+}
 
-    KeyMsg msg;
-    while(1) {
-        // 1. 检查是否有新方向
-        if(xQueueReceive(xKeyQueue, &msg, 0)) {
-            if(!((s_currentDir == DIR_UP && msg.dir == DIR_DOWN) ||     // 防止直接掉头
-                 (s_currentDir == DIR_DOWN && msg.dir == DIR_UP) ||
-                 (s_currentDir == DIR_LEFT && msg.dir == DIR_RIGHT) ||
-                 (s_currentDir == DIR_RIGHT && msg.dir == DIR_LEFT))) {
-                s_currentDir = msg.dir;     
+/* 进行一局游戏，游戏结束时返回 */
+static void prvPlayGame(void) {
+    // 按绝对时间推进游戏：每一拍的截止时间都比上一拍正好晚一个周期，
+    // 与每一拍做了多少工作无关，游戏速度不会漂移
+    vGameClockStart(GAME_TICK_PERIOD_US, GAME_CATCH_UP, GAME_MAX_CATCH_UP);
+
+    // 清空上一局剩下的按键和延迟样本
+    vInputTurnsReset(s_currentDir);
+    vLatencyReset();
+    vLowPowerStatsReset();
+
+    KeyMsg turn;
+
+    while (!s_gameState.gameOver) {
+        // 等到下一拍；错过了节拍并且策略要求追赶时会返回多于一步
+        uint32_t steps = ulGameClockWait();
+
+        while (steps-- > 0 && !s_gameState.gameOver) {
+            // 1. 取下一个转向：按键按顺序缓存，每一步只转一次，
+            //    掉头检查针对上一个接受的转向，所以快速的"上、左"两次转向都有效
+            tBoolean turned = xInputNextTurn(&turn);
+            if (turned) {
+                s_currentDir = turn.dir;
             }
-        }
 
-        // 2. 更新游戏状态 (在互斥锁保护下)
-        if (xSemaphoreTake(xGameStateMutex, portMAX_DELAY) == pdTRUE) {
-            if (!s_gameState.gameOver) {
-                Point newHead = s_gameState.snake[0];
-                switch(s_currentDir) {
-                    case DIR_UP:    newHead.y -= BLOCK_SIZE; break;
-                    case DIR_DOWN:  newHead.y += BLOCK_SIZE; break;
-                    case DIR_LEFT:  newHead.x -= BLOCK_SIZE; break;
-                    case DIR_RIGHT: newHead.x += BLOCK_SIZE; break;
-                    default: break;     //如果接受到按键r则导致蛇头不动，从而导致身体追上蛇头，游戏结束。
-                }                       //本质是个bug，但不影响游戏体验，甚至巧妙做到了“按R键重新开始游戏”的功能
-
-                // 撞墙检测
-                if(newHead.x < 0 || newHead.x >= SCREEN_WIDTH || newHead.y < 0 || newHead.y >= SCREEN_HEIGHT) {
-                    s_gameState.gameOver = true;
-                    // break;
-                }
-
-                // 撞自己检测
-                if (!s_gameState.gameOver) {
-                    for (int i = 1; i < s_gameState.snakeLength; i++) {
-                        if (s_gameState.snake[i].x == newHead.x && s_gameState.snake[i].y == newHead.y) {
-                            s_gameState.gameOver = true;
-                            // break;
-                        }
-                    }
-                }
-
-                if (!s_gameState.gameOver) {
-                    // 1. 检查是否吃到食物
-                    if(newHead.x == s_gameState.food.x && newHead.y == s_gameState.food.y) {
-                        // 如果吃到，先增加长度，再生成新食物
-                        if(s_gameState.snakeLength < MAX_SNAKE_LENGTH) {
-                            s_gameState.snakeLength++;
-                        }
-                        spawnFood();
-                    }
-
-                    // 2. 移动身体
-                    // 这个循环现在可以正确地处理蛇变长的情况
-                    for(int i = s_gameState.snakeLength - 1; i > 0; i--) {
-                        s_gameState.snake[i] = s_gameState.snake[i-1];
-                    }
-                    
-                    // 3. 更新蛇头
-                    s_gameState.snake[0] = newHead;
-                }
-            }
-            xSemaphoreGive(xGameStateMutex);
-        }
+            // 2. 更新游戏状态 (写者不需要等待绘图任务)
+            prvStateWriteBegin();
+            vSnakeGameStep(&s_gameState, s_currentDir);
+            prvStateWriteEnd();
 
-        // 检查游戏是否结束
-        if (s_gameState.gameOver) {
-            break; // 退出循环
+            // 记录这次转向在哪一拍生效，绘图任务画出这一拍时计算延迟
+            if (turned) {
+                vLatencyTurnApplied(turn.ulTimestamp, s_gameState.changes.tick);
+            }
         }
-
-        vTaskDelay(pdMS_TO_TICKS(150));     // 控制游戏速度
     }
 
-    // 游戏结束后，等待一段时间，然后创建重启任务
-    vTaskDelay(pdMS_TO_TICKS(2000));
-    xTaskCreate(vRestart, "Restart", configMINIMAL_STACK_SIZE , NULL, 2, NULL);
-    vTaskDelete(NULL); // 删除自身
+    // 每局结束后把节拍延迟统计从串口输出
+    vGameClockStop();
+    vGameClockStatsPrint();
+    vInputStatsPrint();
+    vLatencyStatsPrint();
+    vLowPowerStatsPrint();
+#if mainSTACK_MONITOR
+    vStackMonitorPrint();
+#endif
 }
 
-void vRestart(void *pvParameters) {
-    // 临时挂起绘图任务，以显示重启提示
-    TaskHandle_t drawTaskHandle = xTaskGetHandle("Draw");
-    if (drawTaskHandle != NULL) {
-        vTaskSuspend(drawTaskHandle);
-    }
+#if mainRESTART_BASELINE
+/* 被删除的蛇任务把收到R键的时刻留给新创建的蛇任务 */
+static tBoolean s_restartPending = false;
+static uint32_t s_restartStart;
+#endif
 
-    vOLEDClear();
-    vOLEDStringDraw("PRESS KEY \"R\"", 5, 20, 0x0F);
-    vOLEDStringDraw("TO RESTART", 5, 40, 0x0F);
+/* 状态机：游戏中 -> 游戏结束 -> 等待重启 -> 游戏中，任务本身一直存在 */
+void vSnakeTask(void *pvParameters) {
+    (void)pvParameters;
     KeyMsg msg;
-    while(1){
-        if(xQueueReceive(xKeyQueue, &msg, 0)) {
-            if(msg.dir == R)  break;
-        }
-        vTaskDelay(pdMS_TO_TICKS(10));
+    uint32_t restartStart;
+
+    vTimestampInit();
+    prvNewGame();
+
+#if mainRESTART_BASELINE
+    if (s_restartPending) {
+        s_restartPending = false;
+        vUARTPrintf("Restart latency (delete/create): %u us\r\n",
+                    (unsigned int)timestampCYCLES_TO_US(ulTimestampGet() - s_restartStart));
     }
+#endif
 
-    // 恢复绘图任务
-    if (drawTaskHandle != NULL) {
-        vTaskResume(drawTaskHandle);
+    for(;;) {
+        prvPlayGame();
+
+        // 游戏结束：绘图任务继续显示 GAME OVER，等待一段时间
+        prvSetPhase(GAME_OVER);
+        vTaskDelay(pdMS_TO_TICKS(2000));
+
+        // 等待重启：按键由串口中断送入队列，这里阻塞等待，不需要轮询
+        prvSetPhase(GAME_WAIT_RESTART);
+        do {
+            xQueueReceive(xKeyQueue, &msg, portMAX_DELAY);
+        } while (msg.dir != R);
+
+        // 重启延迟：从收到 R 键到新一局的状态初始化完成
+        restartStart = msg.ulTimestamp;
+#if mainRESTART_BASELINE
+        // 原来的路径：创建新的蛇任务并删除自己，由新任务初始化并输出延迟
+        s_restartStart = restartStart;
+        s_restartPending = true;
+        xTaskCreate(vSnakeTask, "Snake", SNAKE_TASK_STACK_SIZE, NULL, 2, NULL);
+        vTaskDelete(NULL);
+#else
+        prvNewGame();
+        vUARTPrintf("Restart latency: %u us\r\n",
+                    (unsigned int)timestampCYCLES_TO_US(ulTimestampGet() - restartStart));
+#endif
     }
-    
-    // 创建新的游戏任务，它会自己初始化游戏状态
-    xTaskCreate(vSnakeTask, "Snake", configMINIMAL_STACK_SIZE , NULL, 2, NULL);
-    vTaskDelete(NULL); // 删除自身任务
 }
 
 /*-----------------------------------------------------------*/
@@ -275,21 +363,49 @@ void prvSetupHardware(void) {
     SysCtlClockSet(SYSCTL_SYSDIV_4 | SYSCTL_USE_PLL | SYSCTL_OSC_MAIN | SYSCTL_XTAL_8MHZ);
     SysCtlPeripheralEnable(SYSCTL_PERIPH_UART0);
     UARTEnable(UART0_BASE);
+    vLowPowerInit(); // 选择CPU睡眠时仍然保持时钟的外设
 }
 
 /*-----------------------------------------------------------*/
 int main(void) {
     prvSetupHardware();
 
-    // --- 创建互斥锁和队列 ---
-    xGameStateMutex = xSemaphoreCreateMutex();
-    xKeyQueue = xQueueCreate(KEY_QUEUE_LENGTH, KEY_QUEUE_ITEM_SIZE);
-
-    if (xGameStateMutex != NULL && xKeyQueue != NULL) {
-        // --- 创建任务 ---
-        xTaskCreate(vSnakeTask, "Snake", configMINIMAL_STACK_SIZE , NULL, 2, NULL);
-        xTaskCreate(vDrawTask, "Draw", 1024, NULL, 1, NULL); // 绘图任务优先级可以低一些
-        xTaskCreate(vKeyboardTask, "Keyboard", configMINIMAL_STACK_SIZE , NULL, 3, NULL);
+#if mainRUN_BENCHMARKS
+    vStartBenchmarks(1);
+    vTaskStartScheduler();
+    while(1);
+#endif
+
+    // 所有内核对象都静态分配，不使用堆：创建时间固定，也不会因为内存不足而失败。
+    // 用 -DSNAKE_ZERO_HEAP=ON 编译时整个堆都不链接
+    vTimestampInit();
+    uint32_t createStart = ulTimestampGet();
+
+    // --- 创建队列 ---
+    xKeyQueue = xQueueCreateStatic(KEY_QUEUE_LENGTH, KEY_QUEUE_ITEM_SIZE,
+                                   s_keyQueueStorage, &s_keyQueueStruct);
+
+    if (xKeyQueue != NULL) {
+        // --- 创建任务（静态分配，整个运行期间不删除） ---
+        TaskHandle_t snakeTask = xTaskCreateStatic(vSnakeTask, "Snake", SNAKE_TASK_STACK_SIZE, NULL, 2,
+                                                   s_snakeTaskStack, &s_snakeTaskTCB);
+        TaskHandle_t drawTask = xTaskCreateStatic(vDrawTask, "Draw", DRAW_TASK_STACK_SIZE, NULL, 1,
+                                                  s_drawTaskStack, &s_drawTaskTCB); // 绘图任务优先级可以低一些，不再拷贝游戏状态，栈也不需要很大
+
+        vUARTPrintf("Kernel objects created in %u cycles\r\n",
+                    (unsigned int)(ulTimestampGet() - createStart));
+
+#if mainSTACK_MONITOR
+        vStackMonitorRegister(snakeTask, SNAKE_TASK_STACK_SIZE);
+        vStackMonitorRegister(drawTask, DRAW_TASK_STACK_SIZE);
+        vStartStackMonitor(1);
+#else
+        (void)snakeTask;
+        (void)drawTask;
+#endif
+
+        // 串口接收中断直接把按键送入队列，不再需要键盘轮询任务
+        vInputInit(xKeyQueue);
 
         vTaskStartScheduler();
     }
@@ -305,10 +421,19 @@ void vAssertCalled(const char *pcFile, uint32_t ulLine)
     for(;;);
 }
 
-/* Tick Hook */
+/* Tick Hook：统计实际发生的节拍中断，与经过的节拍数相比就是被省掉的节拍 */
 void vApplicationTickHook(void)
 {
+    vLowPowerTickHook();
+}
+
+#if configUSE_IDLE_HOOK
+/* Idle Hook：不使用 tickless 时，空闲任务在两个节拍之间用 WFI 睡眠 */
+void vApplicationIdleHook(void)
+{
+    vLowPowerIdle();
 }
+#endif
 
 /* Stack Overflow Hook */
 void vApplicationStackOverflowHook(TaskHandle_t pxTask, char *pcTaskName)
@@ -0,0 +1,23 @@
+# Prints the section sizes of an executable and the symbols placed in SRAM
+# (.data and .bss), largest first.
+#
+# cmake -DELF=<file> -DNM=<nm> -DSIZE=<size> -P ram_report.cmake
+
+execute_process(COMMAND ${SIZE} -A -d ${ELF})
+
+execute_process(
+    COMMAND ${NM} --print-size --size-sort --reverse-sort --radix=d ${ELF}
+    OUTPUT_VARIABLE symbols
+)
+
+string(REPLACE "\n" ";" lines "${symbols}")
+set(total 0)
+
+message("SRAM symbols (bytes):")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^[0-9]+ 0*([0-9]+) [bBdD] (.+)$")
+        math(EXPR total "${total} + ${CMAKE_MATCH_1}")
+        message("  ${CMAKE_MATCH_1}\t${CMAKE_MATCH_2}")
+    endif()
+endforeach()
+message("Total: ${total}")
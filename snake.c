@@ -0,0 +1,299 @@
+#include <string.h>
+#include "snake.h"
+
+/* 环形缓冲区下标回绕 */
+#define SNAKE_INDEX(i) ((i) & (MAX_SNAKE_LENGTH - 1))
+
+/* 格子在占用位图中的位置 */
+#define CELL_INDEX(cell) ((uint32_t)(cell).y * BOARD_WIDTH + (cell).x)
+#define CELL_WORD(index) ((index) >> 5)
+#define CELL_BIT(index)  (1UL << ((index) & 31))
+
+/*-----------------------------------------------------------*/
+/* 方向环形缓冲区的读写，每个字节存4个方向 */
+static Direction prvMoveGet(const SnakeBody_t *pxBody, uint32_t index) {
+    index = SNAKE_INDEX(index);
+    return (Direction)((pxBody->moves[index >> 2] >> ((index & 3) * 2)) & 3);
+}
+
+static void prvMoveSet(SnakeBody_t *pxBody, uint32_t index, Direction dir) {
+    uint32_t shift;
+
+    index = SNAKE_INDEX(index);
+    shift = (index & 3) * 2;
+    pxBody->moves[index >> 2] = (pxBody->moves[index >> 2] & ~(3 << shift)) | (dir << shift);
+}
+
+/* 沿某个方向走一步（不检查边界） */
+static Point prvCellStep(Point cell, Direction dir) {
+    switch(dir) {
+        case DIR_UP:    cell.y--; break;
+        case DIR_DOWN:  cell.y++; break;
+        case DIR_LEFT:  cell.x--; break;
+        default:        cell.x++; break;
+    }
+    return cell;
+}
+
+/* 沿某个方向退回一步 */
+static Point prvCellStepBack(Point cell, Direction dir) {
+    switch(dir) {
+        case DIR_UP:    cell.y++; break;
+        case DIR_DOWN:  cell.y--; break;
+        case DIR_LEFT:  cell.x++; break;
+        default:        cell.x--; break;
+    }
+    return cell;
+}
+
+/*-----------------------------------------------------------*/
+/* 蛇身操作 */
+void vSnakeBodyInit(SnakeBody_t *pxBody) {
+    pxBody->next = 0;
+    pxBody->length = 0;
+    memset(pxBody->occupied, 0, sizeof(pxBody->occupied));
+}
+
+/* 在蛇头前面加一节，长度加1
+   （调用者保证长度小于 MAX_SNAKE_LENGTH，且该格子没有被蛇身占用） */
+void vSnakeBodyPushHead(SnakeBody_t *pxBody, Point cell) {
+    uint32_t index = CELL_INDEX(cell);
+    Direction dir;
+
+    if (pxBody->length == 0) {
+        pxBody->tail = cell;
+    } else {
+        if (cell.y < pxBody->head.y) {
+            dir = DIR_UP;
+        } else if (cell.y > pxBody->head.y) {
+            dir = DIR_DOWN;
+        } else if (cell.x < pxBody->head.x) {
+            dir = DIR_LEFT;
+        } else {
+            dir = DIR_RIGHT;
+        }
+        prvMoveSet(pxBody, pxBody->next, dir);
+        pxBody->next = SNAKE_INDEX(pxBody->next + 1);
+    }
+    pxBody->head = cell;
+    pxBody->length++;
+    pxBody->occupied[CELL_WORD(index)] |= CELL_BIT(index);
+}
+
+/* 去掉蛇尾一节，返回被去掉的格子 */
+Point xSnakeBodyPopTail(SnakeBody_t *pxBody) {
+    Point tail = pxBody->tail;
+    uint32_t index = CELL_INDEX(tail);
+
+    pxBody->length--;
+    if (pxBody->length > 0) {
+        // 最早的一步就是从蛇尾走向下一节的方向
+        pxBody->tail = prvCellStep(tail, prvMoveGet(pxBody, pxBody->next - pxBody->length));
+    }
+    pxBody->occupied[CELL_WORD(index)] &= ~CELL_BIT(index);
+    return tail;
+}
+
+Point xSnakeBodyHead(const SnakeBody_t *pxBody) {
+    return pxBody->head;
+}
+
+Point xSnakeBodyTail(const SnakeBody_t *pxBody) {
+    return pxBody->tail;
+}
+
+/*-----------------------------------------------------------*/
+/* 空闲格子查询 */
+tBoolean xSnakeCellFree(const SnakeBody_t *pxBody, Point cell) {
+    uint32_t index = CELL_INDEX(cell);
+
+    return (pxBody->occupied[CELL_WORD(index)] & CELL_BIT(index)) == 0;
+}
+
+uint32_t ulSnakeFreeCellCount(const SnakeBody_t *pxBody) {
+    return BOARD_CELLS - pxBody->length;
+}
+
+/* 统计一个字中置1的位数 */
+static uint32_t prvPopCount(uint32_t word) {
+    word = word - ((word >> 1) & 0x55555555U);
+    word = (word & 0x33333333U) + ((word >> 2) & 0x33333333U);
+    word = (word + (word >> 4)) & 0x0F0F0F0FU;
+    return (word * 0x01010101U) >> 24;
+}
+
+/* 找出第 rank 个（从0开始，按格子编号顺序）空闲格子。
+   逐字统计空闲位数跳过整字，再在目标字内逐个去掉最低位，最后用 CLZ 求位置，
+   最坏情况是 BOARD_CELLS / 32 个字加32次位操作，与蛇长无关。
+   空闲格子不足 rank + 1 个时返回 false */
+tBoolean xSnakeFreeCellSelect(const SnakeBody_t *pxBody, uint32_t rank, Point *pxCell) {
+    uint32_t word, free, count, index;
+
+    for (word = 0; word < BOARD_CELLS / 32; word++) {
+        free = ~pxBody->occupied[word];
+        count = prvPopCount(free);
+        if (rank < count) {
+            while (rank-- > 0) {
+                free &= free - 1;   // 去掉最低的空闲位
+            }
+            index = word * 32 + (31 - __builtin_clz(free & -free));
+            pxCell->x = index % BOARD_WIDTH;
+            pxCell->y = index / BOARD_WIDTH;
+            return true;
+        }
+        rank -= count;
+    }
+    return false;
+}
+
+/*-----------------------------------------------------------*/
+/* 蛇身迭代 */
+void vSnakeIterInit(SnakeIter_t *pxIter, const SnakeBody_t *pxBody) {
+    pxIter->body = pxBody;
+    pxIter->cell = pxBody->head;
+    pxIter->index = pxBody->next;
+    pxIter->remaining = pxBody->length;
+    // 无锁读取时长度可能是写到一半的值，不能越过缓冲区
+    if (pxIter->remaining > MAX_SNAKE_LENGTH) {
+        pxIter->remaining = MAX_SNAKE_LENGTH;
+    }
+}
+
+tBoolean xSnakeIterNext(SnakeIter_t *pxIter, Point *pxCell) {
+    if (pxIter->remaining == 0) {
+        return false;
+    }
+    *pxCell = pxIter->cell;
+    pxIter->remaining--;
+    if (pxIter->remaining > 0) {
+        // 沿着走到这一节的那一步退回上一节
+        pxIter->index--;
+        pxIter->cell = prvCellStepBack(pxIter->cell, prvMoveGet(pxIter->body, pxIter->index));
+    }
+    return true;
+}
+
+/*-----------------------------------------------------------*/
+/* xorshift32 随机数，返回 [0, range) 内的值 */
+static uint32_t prvRandom(GameState_t *pxState, uint32_t range) {
+    uint32_t x = pxState->random;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pxState->random = x;
+
+    // 用乘法取高32位代替取模，避免除法
+    return (uint32_t)(((uint64_t)x * range) >> 32);
+}
+
+/* 工具函数：在所有空闲格子中等概率地随机生成食物 */
+static void spawnFood(GameState_t *pxState) {
+    uint32_t freeCells = ulSnakeFreeCellCount(&pxState->body);
+
+    if (!xSnakeFreeCellSelect(&pxState->body, prvRandom(pxState, freeCells), &pxState->food)) {
+        // 没有空闲格子了：蛇占满了棋盘，赢了
+        pxState->won = true;
+        pxState->gameOver = true;
+    }
+}
+
+/* 开始记录新一拍的变化 */
+static void prvBeginChanges(GameState_t *pxState, tBoolean resync) {
+    pxState->changes.tick++;
+    pxState->changes.resync = resync;
+    pxState->changes.count = 0;
+}
+
+static void prvRecordChange(GameState_t *pxState, Point cell, tBoolean set) {
+    TickChanges_t *pxChanges = &pxState->changes;
+
+    if (pxChanges->count < MAX_TICK_CHANGES) {
+        pxChanges->cells[pxChanges->count].cell = cell;
+        pxChanges->cells[pxChanges->count].set = set;
+        pxChanges->count++;
+    } else {
+        pxChanges->resync = true;  // 不应发生，退化为整屏重绘
+    }
+}
+
+/*-----------------------------------------------------------*/
+/* 设置随机数种子，相同的种子和相同的按键序列会得到相同的一局 */
+void vSnakeGameSeed(GameState_t *pxState, uint32_t seed) {
+    pxState->random = (seed != 0) ? seed : 0x2545F491UL;
+}
+
+/* 开始新的一局 */
+void vSnakeGameInit(GameState_t *pxState) {
+    if (pxState->random == 0) {
+        vSnakeGameSeed(pxState, 0);
+    }
+    pxState->gameOver = false;
+    pxState->won = false;
+    prvBeginChanges(pxState, true);     // 新的一局需要整屏重绘
+
+    // 初始长度为3，放在棋盘中间一行，从蛇尾开始依次加到蛇头前面
+    vSnakeBodyInit(&pxState->body);
+    for (int i = 1; i <= 3; i++) {
+        Point cell = { i, BOARD_HEIGHT / 2 };
+        vSnakeBodyPushHead(&pxState->body, cell);
+    }
+
+    spawnFood(pxState);
+}
+
+/* 游戏前进一拍 */
+void vSnakeGameStep(GameState_t *pxState, Direction dir) {
+    if (pxState->gameOver) {
+        return;
+    }
+
+    Point newHead = xSnakeBodyHead(&pxState->body);
+    Point oldTail = xSnakeBodyTail(&pxState->body);
+    tBoolean grown = false;
+    if (dir <= DIR_RIGHT) {
+        newHead = prvCellStep(newHead, dir);
+    }   //如果接受到按键r则蛇头不动，与自身重合，游戏结束。
+        //本质是个bug，但不影响游戏体验，甚至巧妙做到了“按R键重新开始游戏”的功能
+
+    // 撞墙检测（坐标是无符号的，越过左边或上边会变成很大的数）
+    if(newHead.x >= BOARD_WIDTH || newHead.y >= BOARD_HEIGHT) {
+        pxState->gameOver = true;
+    }
+
+    // 撞自己检测：查占用位图（蛇尾这一拍还没有离开，撞上蛇尾也算）
+    if (!pxState->gameOver && !xSnakeCellFree(&pxState->body, newHead)) {
+        pxState->gameOver = true;
+    }
+
+    if (!pxState->gameOver) {
+        // 1. 检查是否吃到食物，吃到则蛇尾留在原地
+        tBoolean eaten = newHead.x == pxState->food.x && newHead.y == pxState->food.y;
+        if (eaten && pxState->body.length < MAX_SNAKE_LENGTH) {
+            grown = true;
+        }
+
+        // 2. 移动：写入新蛇头，没有变长时去掉蛇尾
+        if (!grown) {
+            xSnakeBodyPopTail(&pxState->body);
+        }
+        vSnakeBodyPushHead(&pxState->body, newHead);
+
+        // 移动之后再生成新食物，保证不会落在新蛇头上
+        if (eaten) {
+            spawnFood(pxState);
+        }
+
+        // 3. 记录这一拍改变的格子，供绘图任务增量绘制
+        prvBeginChanges(pxState, false);
+        if (!grown) {
+            prvRecordChange(pxState, oldTail, false);
+        }
+        prvRecordChange(pxState, newHead, true);
+        prvRecordChange(pxState, pxState->food, true);
+    }
+
+    if (pxState->gameOver) {
+        prvBeginChanges(pxState, true);  // 游戏结束画面需要整屏重绘
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef SNAKE_H
+#define SNAKE_H
+
+/* 贪吃蛇游戏核心：只包含游戏规则和数据结构，不依赖 FreeRTOS 和显示驱动，
+   既被 main.c 的任务使用，也可以在性能测试中单独运行 */
+
+#include <stdint.h>
+#include "hw_types.h"
+
+/* OLED setup constants */
+#define SCREEN_WIDTH 128
+#define SCREEN_HEIGHT 64
+#define BLOCK_SIZE 2          // 一个蛇节占 2x2 像素
+
+/* 棋盘大小（以格子为单位） */
+#define BOARD_WIDTH  (SCREEN_WIDTH / BLOCK_SIZE)
+#define BOARD_HEIGHT (SCREEN_HEIGHT / BLOCK_SIZE)
+#define BOARD_CELLS  (BOARD_WIDTH * BOARD_HEIGHT)
+
+#define MAX_SNAKE_LENGTH BOARD_CELLS  // 蛇可以占满整个棋盘，必须是2的幂
+
+/* 数据结构 */
+/* 格子坐标（不是像素坐标），只有绘图时才乘以 BLOCK_SIZE 换算成像素 */
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} Point;
+
+typedef enum {
+    DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT, R
+} Direction;
+
+// --- 每个游戏节拍产生的格子变化 ---
+// 每一拍最多改变三个格子：新的蛇头、离开的蛇尾和新生成的食物
+#define MAX_TICK_CHANGES 3
+
+typedef struct {
+    Point cell;
+    tBoolean set;           // true: 点亮该格子, false: 熄灭该格子
+} CellChange;
+
+typedef struct {
+    uint32_t tick;          // 每次游戏状态改变时加1
+    tBoolean resync;        // 需要整屏重绘（重新开始或游戏结束）
+    int count;
+    CellChange cells[MAX_TICK_CHANGES];
+} TickChanges_t;
+
+// --- 蛇身：方向环形缓冲区 ---
+// 相邻两节之间只差一步，所以只保存蛇头、蛇尾的坐标和每一步移动的方向（2位）。
+// moves 是环形缓冲区，第 (next - 1) 项是走到蛇头的那一步，向前依次到蛇尾，
+// 共 length - 1 项。蛇头前进一步写入一个方向，蛇尾离开时读出一个方向，都是 O(1)。
+// occupied 是占用位图，每个格子一位（第 y * BOARD_WIDTH + x 位），
+// 随蛇头加入、蛇尾离开同步更新，查询某个格子是否被蛇身占用只需读一次
+typedef struct {
+    uint8_t moves[MAX_SNAKE_LENGTH / 4];
+    Point head;
+    Point tail;
+    uint16_t next;          // 下一步方向写入的位置
+    uint16_t length;
+    uint32_t occupied[BOARD_CELLS / 32];
+} SnakeBody_t;
+
+// --- 蛇身迭代器：从蛇头到蛇尾依次访问每一节 ---
+typedef struct {
+    const SnakeBody_t *body;
+    Point cell;
+    uint32_t index;
+    uint32_t remaining;
+} SnakeIter_t;
+
+// --- 共享的游戏状态结构体 ---
+typedef struct {
+    SnakeBody_t body;
+    Point food;
+    tBoolean gameOver;
+    tBoolean won;           // 蛇占满了整个棋盘
+    TickChanges_t changes;  // 最近一拍的变化列表
+    uint32_t random;        // xorshift32 随机数状态，不能为0
+} GameState_t;
+
+/* 蛇身操作，均为 O(1)。新蛇头必须与原蛇头相邻（第一节除外） */
+void vSnakeBodyInit(SnakeBody_t *pxBody);
+void vSnakeBodyPushHead(SnakeBody_t *pxBody, Point cell);
+Point xSnakeBodyPopTail(SnakeBody_t *pxBody);
+Point xSnakeBodyHead(const SnakeBody_t *pxBody);
+Point xSnakeBodyTail(const SnakeBody_t *pxBody);
+
+/* 空闲格子查询（cell 必须在棋盘内） */
+tBoolean xSnakeCellFree(const SnakeBody_t *pxBody, Point cell);
+uint32_t ulSnakeFreeCellCount(const SnakeBody_t *pxBody);
+tBoolean xSnakeFreeCellSelect(const SnakeBody_t *pxBody, uint32_t rank, Point *pxCell);
+
+/* 蛇身迭代 */
+void vSnakeIterInit(SnakeIter_t *pxIter, const SnakeBody_t *pxBody);
+tBoolean xSnakeIterNext(SnakeIter_t *pxIter, Point *pxCell);
+
+/* 游戏规则 */
+void vSnakeGameSeed(GameState_t *pxState, uint32_t seed);
+void vSnakeGameInit(GameState_t *pxState);
+void vSnakeGameStep(GameState_t *pxState, Direction dir);
+
+#endif
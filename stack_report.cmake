@@ -0,0 +1,109 @@
+# Estimates the worst case stack use of each task from the call graph files
+# written by -fcallgraph-info=su, and recommends a stack size with headroom.
+#
+# cmake -DDIR=<build dir> -DENTRIES=<function;...> -DHEADROOM=<percent> -P stack_report.cmake
+#
+# The estimate is the deepest path through the call graph plus the 16 words
+# saved on the task stack by an exception entry and a context switch.  Calls
+# through function pointers and into libraries built without the call graph
+# (libdriver.a, libgr.a) cannot be followed, so they are listed and the
+# runtime monitor (LocalDemoFiles/stackmon.c) must cover them.
+
+set(CONTEXT_BYTES 64)
+
+file(GLOB_RECURSE ci_files "${DIR}/*.ci")
+set(nodes "")
+
+foreach(file IN LISTS ci_files)
+    file(STRINGS "${file}" lines)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^node: { title: \"([^\"]+)\" label: \"[^\"]*\\\\n([0-9]+) bytes \\(([a-z,]+)\\)\"")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+            list(APPEND nodes "${CMAKE_MATCH_1}")
+            set(frame_${id} ${CMAKE_MATCH_2})
+            if(NOT CMAKE_MATCH_3 STREQUAL "static")
+                set(dynamic_${id} TRUE)
+            endif()
+        elseif(line MATCHES "^edge: { sourcename: \"([^\"]+)\" targetname: \"([^\"]+)\"")
+            string(MAKE_C_IDENTIFIER "${CMAKE_MATCH_1}" id)
+            list(APPEND calls_${id} "${CMAKE_MATCH_2}")
+        endif()
+    endforeach()
+endforeach()
+
+# Depth of the deepest path starting at function name, in bytes.  Results are
+# kept in global properties as CMake functions cannot return to anything but
+# the caller's scope.
+function(worst_case name result)
+    string(MAKE_C_IDENTIFIER "${name}" id)
+
+    get_property(known GLOBAL PROPERTY depth_${id} SET)
+    if(known)
+        get_property(depth GLOBAL PROPERTY depth_${id})
+        set(${result} ${depth} PARENT_SCOPE)
+        return()
+    endif()
+
+    get_property(active GLOBAL PROPERTY active_${id})
+    if(active)
+        set_property(GLOBAL APPEND PROPERTY notes "recursion through ${name}")
+        set(${result} 0 PARENT_SCOPE)
+        return()
+    endif()
+    set_property(GLOBAL PROPERTY active_${id} TRUE)
+
+    if(DEFINED frame_${id})
+        set(frame ${frame_${id}})
+        if(dynamic_${id})
+            set_property(GLOBAL APPEND PROPERTY notes "dynamic stack in ${name}")
+        endif()
+    else()
+        set(frame 0)
+        set_property(GLOBAL APPEND PROPERTY notes "not followed: ${name}")
+    endif()
+
+    set(deepest 0)
+    foreach(callee IN LISTS calls_${id})
+        worst_case("${callee}" depth)
+        if(depth GREATER deepest)
+            set(deepest ${depth})
+        endif()
+    endforeach()
+
+    math(EXPR depth "${frame} + ${deepest}")
+    set_property(GLOBAL PROPERTY active_${id} FALSE)
+    set_property(GLOBAL PROPERTY depth_${id} ${depth})
+    set(${result} ${depth} PARENT_SCOPE)
+endfunction()
+
+message("Static worst case stack use (bytes, words recommended with ${HEADROOM}% headroom):")
+foreach(entry IN LISTS ENTRIES)
+    # Static functions are named file:function in the call graph.
+    set(found "")
+    foreach(node IN LISTS nodes)
+        if(node STREQUAL entry OR node MATCHES ":${entry}$")
+            set(found "${node}")
+            break()
+        endif()
+    endforeach()
+
+    if(found STREQUAL "")
+        message("  ${entry}: not found")
+        continue()
+    endif()
+
+    worst_case("${found}" depth)
+    math(EXPR bytes "${depth} + ${CONTEXT_BYTES}")
+    math(EXPR words "(${bytes} * (100 + ${HEADROOM}) + 399) / 400")
+    message("  ${entry}: ${bytes} bytes, recommend ${words} words")
+endforeach()
+
+get_property(notes GLOBAL PROPERTY notes)
+if(notes)
+    list(REMOVE_DUPLICATES notes)
+    list(SORT notes)
+    message("Not included in the estimates above:")
+    foreach(note IN LISTS notes)
+        message("  ${note}")
+    endforeach()
+endif()
@@ -47,6 +47,8 @@ extern void vPortSVCHandler( void );
 extern void Timer0IntHandler( void );
 extern void vT2InterruptHandler( void );
 extern void vT3InterruptHandler( void );
+extern void OSRAM128x64x4IntHandler( void );
+extern void UART0IntHandler( void );
 void vAssertCalled( const char *pcFile, unsigned long ulLine );
 
 //*****************************************************************************
@@ -91,9 +93,9 @@ void (* const g_pfnVectors[])(void) =
     IntDefaultHandler,                      // GPIO Port C
     IntDefaultHandler,                      // GPIO Port D
     IntDefaultHandler,                      // GPIO Port E
-    IntDefaultHandler,                      // UART0 Rx and Tx
+    UART0IntHandler,                        // UART0 Rx and Tx
     IntDefaultHandler,                      // UART1 Rx and Tx
-    IntDefaultHandler,                      // SSI Rx and Tx
+    OSRAM128x64x4IntHandler,                // SSI Rx and Tx
     IntDefaultHandler,                      // I2C Master and Slave
     IntDefaultHandler,                      // PWM Fault
     IntDefaultHandler,                      // PWM Generator 0